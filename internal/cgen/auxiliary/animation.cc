@@ -0,0 +1,785 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// ---------------- Auxiliary - Animation
+
+#if !defined(WUFFS_CONFIG__MODULES) || \
+    defined(WUFFS_CONFIG__MODULE__AUX__ANIMATION)
+
+#include <atomic>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace wuffs_aux {
+
+const char AnimationDecoder_BadCallSequence[] =  //
+    "wuffs_aux::AnimationDecoder: bad call sequence";
+const char AnimationDecoder_EndOfAnimation[] =  //
+    "wuffs_aux::AnimationDecoder: end of animation";
+const char AnimationDecoder_MaxInclDimensionExceeded[] =  //
+    "wuffs_aux::AnimationDecoder: max_incl_dimension exceeded";
+const char AnimationDecoder_OutOfMemory[] =  //
+    "wuffs_aux::AnimationDecoder: out of memory";
+const char AnimationDecoder_UnexpectedEndOfFile[] =  //
+    "wuffs_aux::AnimationDecoder: unexpected end of file";
+const char AnimationDecoder_UnsupportedImageFormat[] =  //
+    "wuffs_aux::AnimationDecoder: unsupported image format";
+const char AnimationDecoder_UnsupportedPixelConfiguration[] =  //
+    "wuffs_aux::AnimationDecoder: unsupported pixel configuration";
+
+const char ParallelGifDecoder_BadCallSequence[] =  //
+    "wuffs_aux::ParallelGifDecoder: bad call sequence";
+const char ParallelGifDecoder_EndOfAnimation[] =  //
+    "wuffs_aux::ParallelGifDecoder: end of animation";
+const char ParallelGifDecoder_MaxInclDimensionExceeded[] =  //
+    "wuffs_aux::ParallelGifDecoder: max_incl_dimension exceeded";
+const char ParallelGifDecoder_OutOfMemory[] =  //
+    "wuffs_aux::ParallelGifDecoder: out of memory";
+const char ParallelGifDecoder_UnexpectedEndOfFile[] =  //
+    "wuffs_aux::ParallelGifDecoder: unexpected end of file";
+const char ParallelGifDecoder_UnsupportedImageFormat[] =  //
+    "wuffs_aux::ParallelGifDecoder: unsupported image format";
+const char ParallelGifDecoder_UnsupportedPixelConfiguration[] =  //
+    "wuffs_aux::ParallelGifDecoder: unsupported pixel configuration";
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+
+namespace {
+
+// AnimationDecoderAsPng returns image_decoder as a wuffs_png__decoder, or
+// nullptr if its concrete type is something else. A custom SelectDecoder can
+// return some other implementation for WUFFS_BASE__FOURCC__PNG.
+wuffs_png__decoder*  //
+AnimationDecoderAsPng(wuffs_base__image_decoder* image_decoder) {
+  if (image_decoder &&
+      (image_decoder->private_impl.first_vtable.vtable_name ==
+       wuffs_base__image_decoder__vtable_name) &&
+      (image_decoder->private_impl.first_vtable.function_pointers ==
+       static_cast<const void*>(
+           &wuffs_png__decoder__func_ptrs_for__wuffs_base__image_decoder))) {
+    return reinterpret_cast<wuffs_png__decoder*>(image_decoder);
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__PNG)
+
+AnimationDecoder::AnimationDecoder(const uint8_t* ptr,
+                                   size_t len,
+                                   uint64_t snapshot_budget,
+                                   uint64_t snapshot_interval)
+    : m_ptr(ptr),
+      m_len(len),
+      m_snapshot_budget(snapshot_budget),
+      m_snapshot_interval((snapshot_interval > 0) ? snapshot_interval : 1),
+      m_image_decoder(nullptr),
+      m_io_buf(wuffs_base__empty_io_buffer()),
+      m_image_config(wuffs_base__null_image_config()),
+      m_canvas(wuffs_base__null_pixel_buffer()),
+      m_canvas_len(0),
+      m_canvas_array(nullptr),
+      m_prev_array(nullptr),
+      m_workbuf_array(nullptr),
+      m_workbuf(wuffs_base__empty_slice_u8()),
+      m_frame_config(wuffs_base__null_frame_config()),
+      m_frame_index(NoFrame),
+      m_num_frames_seen(0),
+      m_end_of_animation_seen(false),
+      m_keyframes(),
+      m_snapshot_bytes(0) {}
+
+AnimationDecoder::~AnimationDecoder() {}
+
+wuffs_base__image_decoder::unique_ptr  //
+AnimationDecoder::SelectDecoder(uint32_t fourcc,
+                                wuffs_base__slice_u8 prefix_data,
+                                bool prefix_closed) {
+  switch (fourcc) {
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
+    case WUFFS_BASE__FOURCC__GIF:
+      return wuffs_gif__decoder::alloc_as__wuffs_base__image_decoder();
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+    case WUFFS_BASE__FOURCC__PNG: {
+      auto dec = wuffs_png__decoder::alloc_as__wuffs_base__image_decoder();
+      // Favor faster decodes over rejecting invalid checksums.
+      dec->set_quirk(WUFFS_BASE__QUIRK_IGNORE_CHECKSUM, 1);
+      return dec;
+    }
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBM)
+    case WUFFS_BASE__FOURCC__WEBM:
+      return wuffs_webm__decoder::alloc_as__wuffs_base__image_decoder();
+#endif
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+    case WUFFS_BASE__FOURCC__WEBP:
+      return wuffs_webp__decoder::alloc_as__wuffs_base__image_decoder();
+#endif
+  }
+
+  return wuffs_base__image_decoder::unique_ptr(nullptr);
+}
+
+std::string  //
+AnimationDecoder::DecodeImageConfig(const QuirkKeyValuePair* quirks_ptr,
+                                    size_t quirks_len,
+                                    uint32_t max_incl_dimension) {
+  if (m_image_decoder) {
+    return AnimationDecoder_BadCallSequence;
+  }
+  m_io_buf = wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(m_ptr), m_len,
+                                        true);
+
+  // Select the image decoder and apply quirks.
+  int32_t fourcc = wuffs_base__magic_number_guess_fourcc(
+      m_io_buf.reader_slice(), m_io_buf.meta.closed);
+  m_image_decoder =
+      SelectDecoder((fourcc > 0) ? ((uint32_t)fourcc) : 0,
+                    m_io_buf.reader_slice(), m_io_buf.meta.closed);
+  if (!m_image_decoder) {
+    return AnimationDecoder_UnsupportedImageFormat;
+  }
+  for (size_t i = 0; i < quirks_len; i++) {
+    m_image_decoder->set_quirk(quirks_ptr[i].first, quirks_ptr[i].second);
+  }
+
+  // Decode the image config. The whole input is in memory, so there is no
+  // point in retrying on a short read.
+  wuffs_base__status dic_status =
+      m_image_decoder->decode_image_config(&m_image_config, &m_io_buf);
+  if (dic_status.repr == wuffs_base__suspension__short_read) {
+    return AnimationDecoder_UnexpectedEndOfFile;
+  } else if (dic_status.repr == wuffs_base__note__i_o_redirect) {
+    return AnimationDecoder_UnsupportedImageFormat;
+  } else if (dic_status.repr != nullptr) {
+    return dic_status.message();
+  }
+
+  // Allocate the canvas, the RESTORE_PREVIOUS backup and the work buffer.
+  uint32_t w = m_image_config.pixcfg.width();
+  uint32_t h = m_image_config.pixcfg.height();
+  if ((w > max_incl_dimension) || (h > max_incl_dimension)) {
+    return AnimationDecoder_MaxInclDimensionExceeded;
+  }
+  m_image_config.pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                            WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, w, h);
+  uint64_t len = m_image_config.pixcfg.pixbuf_len();
+  if ((len == 0) || (SIZE_MAX < len)) {
+    return AnimationDecoder_UnsupportedPixelConfiguration;
+  }
+  m_canvas_len = (size_t)len;
+  m_canvas_array.reset(new (std::nothrow) uint8_t[m_canvas_len]);
+  m_prev_array.reset(new (std::nothrow) uint8_t[m_canvas_len]);
+  if (!m_canvas_array || !m_prev_array) {
+    return AnimationDecoder_OutOfMemory;
+  }
+  wuffs_base__status sfs_status = m_canvas.set_from_slice(
+      &m_image_config.pixcfg,
+      wuffs_base__make_slice_u8(m_canvas_array.get(), m_canvas_len));
+  if (!sfs_status.is_ok()) {
+    return sfs_status.message();
+  }
+
+  uint64_t workbuf_len = m_image_decoder->workbuf_len().max_incl;
+  if (SIZE_MAX < workbuf_len) {
+    return AnimationDecoder_OutOfMemory;
+  } else if (workbuf_len > 0) {
+    m_workbuf_array.reset(new (std::nothrow) uint8_t[(size_t)workbuf_len]);
+    if (!m_workbuf_array) {
+      return AnimationDecoder_OutOfMemory;
+    }
+    m_workbuf = wuffs_base__make_slice_u8(m_workbuf_array.get(),
+                                          (size_t)workbuf_len);
+  }
+  return "";
+}
+
+std::string  //
+AnimationDecoder::SeekFrame(uint64_t frame_index) {
+  if (!m_canvas_array) {
+    return AnimationDecoder_BadCallSequence;
+  } else if (m_frame_index == frame_index) {
+    return "";
+  } else if (m_end_of_animation_seen && (frame_index >= m_num_frames_seen)) {
+    return AnimationDecoder_EndOfAnimation;
+  }
+
+  // Find the nearest keyframe at or before frame_index. Keyframes are sorted
+  // by index and, once DecodeNextFrame has been called, the first keyframe is
+  // always frame 0.
+  size_t k = m_keyframes.size();
+  while ((k > 0) && (m_keyframes[k - 1].index > frame_index)) {
+    k--;
+  }
+
+  // Restart from that keyframe, unless the canvas already holds a frame
+  // between that keyframe and frame_index. Restarting from a keyframe with a
+  // snapshot means copying that snapshot onto the canvas. Otherwise, the
+  // canvas' prior contents do not matter.
+  if ((k > 0) && ((m_frame_index == NoFrame) ||
+                  (m_frame_index < m_keyframes[k - 1].index) ||
+                  (m_frame_index > frame_index))) {
+    const Keyframe& kf = m_keyframes[k - 1];
+    m_frame_index = NoFrame;
+    m_frame_config = wuffs_base__null_frame_config();
+    wuffs_base__status rf_status =
+        m_image_decoder->restart_frame(kf.index, kf.io_position);
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+    wuffs_png__decoder* png_decoder =
+        AnimationDecoderAsPng(m_image_decoder.get());
+    if (rf_status.is_ok() && png_decoder && (kf.index > 0)) {
+      rf_status = png_decoder->set_next_animation_sequence_number(
+          kf.apng_sequence_number);
+    }
+#endif
+    if (!rf_status.is_ok()) {
+      return rf_status.message();
+    } else if (kf.io_position > m_io_buf.meta.wi) {
+      return AnimationDecoder_UnexpectedEndOfFile;
+    }
+    m_io_buf.meta.ri = (size_t)kf.io_position;
+    if (kf.snapshot) {
+      memcpy(m_canvas_array.get(), kf.snapshot.get(), m_canvas_len);
+    }
+  }
+
+  while (m_frame_index != frame_index) {
+    std::string error_message = DecodeNextFrame();
+    if (!error_message.empty()) {
+      return error_message;
+    }
+  }
+  return "";
+}
+
+std::string  //
+AnimationDecoder::DecodeNextFrame() {
+  // Apply the previous frame's disposal.
+  if (m_frame_index != NoFrame) {
+    switch (m_frame_config.disposal()) {
+      case WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND:
+        m_canvas.set_color_u32_fill_rect(m_frame_config.bounds(),
+                                         m_frame_config.background_color());
+        break;
+      case WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS:
+        memcpy(m_canvas_array.get(), m_prev_array.get(), m_canvas_len);
+        break;
+    }
+  }
+  m_frame_index = NoFrame;
+
+  // Decode the frame config. For APNG, first note the sequence number that
+  // its fcTL chunk should have, in case this frame becomes a keyframe.
+  uint32_t apng_sequence_number = 0;
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+  wuffs_png__decoder* png_decoder =
+      AnimationDecoderAsPng(m_image_decoder.get());
+  if (png_decoder) {
+    apng_sequence_number = png_decoder->next_animation_sequence_number();
+  }
+#endif
+  wuffs_base__frame_config fc = wuffs_base__null_frame_config();
+  wuffs_base__status dfc_status =
+      m_image_decoder->decode_frame_config(&fc, &m_io_buf);
+  if (dfc_status.repr == wuffs_base__note__end_of_data) {
+    m_end_of_animation_seen = true;
+    return AnimationDecoder_EndOfAnimation;
+  } else if (dfc_status.repr == wuffs_base__suspension__short_read) {
+    return AnimationDecoder_UnexpectedEndOfFile;
+  } else if (dfc_status.repr != nullptr) {
+    return dfc_status.message();
+  }
+  if (fc.index() == 0) {
+    m_canvas.set_color_u32_fill_rect(m_canvas.pixcfg.bounds(),
+                                     fc.background_color());
+  }
+  if (fc.index() >= m_num_frames_seen) {
+    MaybeRecordKeyframe(fc, apng_sequence_number);
+    m_num_frames_seen = fc.index() + 1;
+  }
+  if (fc.disposal() == WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS) {
+    memcpy(m_prev_array.get(), m_canvas_array.get(), m_canvas_len);
+  }
+
+  // Decode the frame (the pixels).
+  wuffs_base__status df_status = m_image_decoder->decode_frame(
+      &m_canvas, &m_io_buf,
+      fc.overwrite_instead_of_blend() ? WUFFS_BASE__PIXEL_BLEND__SRC
+                                      : WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+      m_workbuf, nullptr);
+  if (df_status.repr == wuffs_base__suspension__short_read) {
+    return AnimationDecoder_UnexpectedEndOfFile;
+  } else if (df_status.repr != nullptr) {
+    return df_status.message();
+  }
+  m_frame_config = fc;
+  m_frame_index = fc.index();
+  return "";
+}
+
+void  //
+AnimationDecoder::MaybeRecordKeyframe(const wuffs_base__frame_config& fc,
+                                      uint32_t apng_sequence_number) {
+  Keyframe kf;
+  kf.index = fc.index();
+  kf.io_position = fc.io_position();
+  kf.apng_sequence_number = apng_sequence_number;
+  kf.snapshot = nullptr;
+
+  // Frame 0, or a frame that replaces every canvas pixel, does not need a
+  // snapshot. RESTORE_PREVIOUS would restore the unknown prior contents.
+  if ((kf.index == 0) ||
+      (fc.bounds().equals(m_canvas.pixcfg.bounds()) &&
+       (fc.overwrite_instead_of_blend() || fc.opaque_within_bounds()) &&
+       (fc.disposal() != WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS))) {
+    m_keyframes.push_back(std::move(kf));
+    return;
+  }
+
+  if ((m_snapshot_budget < m_canvas_len) || m_keyframes.empty() ||
+      ((kf.index - m_keyframes.back().index) < m_snapshot_interval)) {
+    return;
+  }
+
+  // Stay within budget by dropping every second snapshot (keeping those
+  // keyframes that do not need one) and doubling the snapshot interval.
+  if ((m_snapshot_budget - m_canvas_len) < m_snapshot_bytes) {
+    size_t j = 0;
+    bool drop = true;
+    for (size_t i = 0; i < m_keyframes.size(); i++) {
+      if (m_keyframes[i].snapshot) {
+        drop = !drop;
+        if (drop) {
+          m_snapshot_bytes -= m_canvas_len;
+          continue;
+        }
+      }
+      if (i != j) {
+        m_keyframes[j] = std::move(m_keyframes[i]);
+      }
+      j++;
+    }
+    m_keyframes.resize(j);
+    if (m_snapshot_interval <= (UINT64_MAX / 2)) {
+      m_snapshot_interval *= 2;
+    }
+    if ((m_snapshot_budget - m_canvas_len) < m_snapshot_bytes) {
+      return;
+    }
+  }
+
+  kf.snapshot.reset(new (std::nothrow) uint8_t[m_canvas_len]);
+  if (!kf.snapshot) {
+    return;
+  }
+  memcpy(kf.snapshot.get(), m_canvas_array.get(), m_canvas_len);
+  m_snapshot_bytes += m_canvas_len;
+  m_keyframes.push_back(std::move(kf));
+}
+
+const wuffs_base__image_config&  //
+AnimationDecoder::ImageConfig() const {
+  return m_image_config;
+}
+
+const wuffs_base__pixel_buffer&  //
+AnimationDecoder::Canvas() const {
+  return m_canvas;
+}
+
+const wuffs_base__frame_config&  //
+AnimationDecoder::FrameConfig() const {
+  return m_frame_config;
+}
+
+uint64_t  //
+AnimationDecoder::NumFramesSeen() const {
+  return m_num_frames_seen;
+}
+
+bool  //
+AnimationDecoder::EndOfAnimationSeen() const {
+  return m_end_of_animation_seen;
+}
+
+size_t  //
+AnimationDecoder::NumKeyframes() const {
+  return m_keyframes.size();
+}
+
+uint64_t  //
+AnimationDecoder::SnapshotBytes() const {
+  return m_snapshot_bytes;
+}
+
+// --------
+
+namespace {
+
+uint32_t  //
+ParallelGifDecoderNumThreads(uint32_t num_threads) {
+  if (num_threads == 0) {
+    num_threads = std::thread::hardware_concurrency();
+  }
+  return (num_threads > 0) ? num_threads : 1;
+}
+
+}  // namespace
+
+ParallelGifDecoder::Slot::Slot()
+    : decoder(nullptr),
+      indexes(wuffs_base__null_pixel_buffer()),
+      indexes_array(nullptr),
+      palette_array(nullptr),
+      workbuf_array(nullptr),
+      workbuf(wuffs_base__empty_slice_u8()),
+      frame_config(wuffs_base__null_frame_config()),
+      error_message() {}
+
+ParallelGifDecoder::ParallelGifDecoder(const uint8_t* ptr,
+                                       size_t len,
+                                       uint32_t num_threads)
+    : m_ptr(ptr),
+      m_len(len),
+      m_num_threads(ParallelGifDecoderNumThreads(num_threads)),
+      m_scanner(nullptr),
+      m_io_buf(wuffs_base__empty_io_buffer()),
+      m_image_config(wuffs_base__null_image_config()),
+      m_canvas(wuffs_base__null_pixel_buffer()),
+      m_canvas_len(0),
+      m_canvas_array(nullptr),
+      m_prev_array(nullptr),
+      m_slots(),
+      m_batch_len(0),
+      m_batch_ri(0),
+      m_scan_error_message(),
+      m_error_message(),
+      m_frame_config(wuffs_base__null_frame_config()),
+      m_have_frame(false) {}
+
+ParallelGifDecoder::~ParallelGifDecoder() {}
+
+void  //
+ParallelGifDecoder::RunTasks(size_t num_tasks,
+                             const std::function<void(size_t)>& task) {
+  std::atomic<size_t> next_task(0);
+  auto worker = [&]() {
+    while (true) {
+      size_t i = next_task.fetch_add(1);
+      if (i >= num_tasks) {
+        break;
+      }
+      task(i);
+    }
+  };
+
+  size_t num_threads = (num_tasks < m_num_threads) ? num_tasks : m_num_threads;
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < num_threads; i++) {
+    threads.emplace_back(worker);
+  }
+  worker();
+  for (auto& t : threads) {
+    t.join();
+  }
+}
+
+std::string  //
+ParallelGifDecoder::DecodeImageConfig(const QuirkKeyValuePair* quirks_ptr,
+                                      size_t quirks_len,
+                                      uint32_t max_incl_dimension) {
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__GIF)
+  if (m_scanner) {
+    return ParallelGifDecoder_BadCallSequence;
+  }
+  m_io_buf = wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(m_ptr), m_len,
+                                        true);
+  int32_t fourcc = wuffs_base__magic_number_guess_fourcc(
+      m_io_buf.reader_slice(), m_io_buf.meta.closed);
+  if (fourcc != WUFFS_BASE__FOURCC__GIF) {
+    return ParallelGifDecoder_UnsupportedImageFormat;
+  }
+
+  // Every low-level decoder (the scanner and one per slot) decodes the image
+  // config, so that each can restart_frame independently.
+  m_scanner = wuffs_gif__decoder::alloc_as__wuffs_base__image_decoder();
+  m_slots.resize(m_num_threads);
+  for (size_t i = 0; i <= m_slots.size(); i++) {
+    wuffs_base__image_decoder::unique_ptr& dec =
+        (i == 0) ? m_scanner : m_slots[i - 1].decoder;
+    if (i > 0) {
+      dec = wuffs_gif__decoder::alloc_as__wuffs_base__image_decoder();
+    }
+    if (!dec) {
+      return ParallelGifDecoder_OutOfMemory;
+    }
+    for (size_t j = 0; j < quirks_len; j++) {
+      dec->set_quirk(quirks_ptr[j].first, quirks_ptr[j].second);
+    }
+
+    // The whole input is in memory, so there is no point in retrying on a
+    // short read.
+    wuffs_base__image_config ic = wuffs_base__null_image_config();
+    wuffs_base__io_buffer io_buf =
+        wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(m_ptr), m_len, true);
+    wuffs_base__status dic_status = dec->decode_image_config(&ic, &io_buf);
+    if (dic_status.repr == wuffs_base__suspension__short_read) {
+      return ParallelGifDecoder_UnexpectedEndOfFile;
+    } else if (dic_status.repr != nullptr) {
+      return dic_status.message();
+    }
+    if (i == 0) {
+      m_image_config = ic;
+      m_io_buf = io_buf;
+    }
+  }
+
+  // Allocate the canvas and the RESTORE_PREVIOUS backup.
+  uint32_t w = m_image_config.pixcfg.width();
+  uint32_t h = m_image_config.pixcfg.height();
+  if ((w > max_incl_dimension) || (h > max_incl_dimension)) {
+    return ParallelGifDecoder_MaxInclDimensionExceeded;
+  }
+  m_image_config.pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                            WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, w, h);
+  uint64_t len = m_image_config.pixcfg.pixbuf_len();
+  if ((len == 0) || (SIZE_MAX < len)) {
+    return ParallelGifDecoder_UnsupportedPixelConfiguration;
+  }
+  m_canvas_len = (size_t)len;
+  m_canvas_array.reset(new (std::nothrow) uint8_t[m_canvas_len]);
+  m_prev_array.reset(new (std::nothrow) uint8_t[m_canvas_len]);
+  if (!m_canvas_array || !m_prev_array) {
+    return ParallelGifDecoder_OutOfMemory;
+  }
+  wuffs_base__status sfs_status = m_canvas.set_from_slice(
+      &m_image_config.pixcfg,
+      wuffs_base__make_slice_u8(m_canvas_array.get(), m_canvas_len));
+  if (!sfs_status.is_ok()) {
+    return sfs_status.message();
+  }
+
+  // Allocate each slot's palette indexes (1 byte per pixel) and work buffer.
+  wuffs_base__pixel_config indexes_pixcfg;
+  indexes_pixcfg.set(WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY,
+                     WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, w, h);
+  size_t indexes_len = m_canvas_len / 4;
+  uint64_t workbuf_len = m_scanner->workbuf_len().max_incl;
+  if (SIZE_MAX < workbuf_len) {
+    return ParallelGifDecoder_OutOfMemory;
+  }
+  for (auto& slot : m_slots) {
+    slot.indexes_array.reset(new (std::nothrow) uint8_t[indexes_len]);
+    slot.palette_array.reset(
+        new (std::nothrow)
+            uint8_t[WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH]);
+    if (!slot.indexes_array || !slot.palette_array) {
+      return ParallelGifDecoder_OutOfMemory;
+    }
+    wuffs_base__status si_status = slot.indexes.set_interleaved(
+        &indexes_pixcfg,
+        wuffs_base__make_table_u8(slot.indexes_array.get(), w, h, w),
+        wuffs_base__make_slice_u8(
+            slot.palette_array.get(),
+            WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH));
+    if (!si_status.is_ok()) {
+      return si_status.message();
+    }
+    if (workbuf_len > 0) {
+      slot.workbuf_array.reset(new (std::nothrow) uint8_t[(size_t)workbuf_len]);
+      if (!slot.workbuf_array) {
+        return ParallelGifDecoder_OutOfMemory;
+      }
+      slot.workbuf = wuffs_base__make_slice_u8(slot.workbuf_array.get(),
+                                               (size_t)workbuf_len);
+    }
+  }
+  return "";
+#else
+  return ParallelGifDecoder_UnsupportedImageFormat;
+#endif
+}
+
+std::string  //
+ParallelGifDecoder::DecodeNextFrame() {
+  if (!m_error_message.empty()) {
+    return m_error_message;
+  } else if (!m_canvas_array) {
+    return ParallelGifDecoder_BadCallSequence;
+  }
+
+  if (m_batch_ri >= m_batch_len) {
+    m_error_message = DecodeNextBatch();
+    if (!m_error_message.empty()) {
+      return m_error_message;
+    }
+  }
+  Slot& slot = m_slots[m_batch_ri++];
+  if (!slot.error_message.empty()) {
+    m_error_message = slot.error_message;
+    return m_error_message;
+  }
+
+  // Apply the previous frame's disposal.
+  if (m_have_frame) {
+    switch (m_frame_config.disposal()) {
+      case WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_BACKGROUND:
+        m_canvas.set_color_u32_fill_rect(m_frame_config.bounds(),
+                                         m_frame_config.background_color());
+        break;
+      case WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS:
+        memcpy(m_canvas_array.get(), m_prev_array.get(), m_canvas_len);
+        break;
+    }
+  }
+
+  const wuffs_base__frame_config& fc = slot.frame_config;
+  if (fc.index() == 0) {
+    m_canvas.set_color_u32_fill_rect(m_canvas.pixcfg.bounds(),
+                                     fc.background_color());
+  }
+  if (fc.disposal() == WUFFS_BASE__ANIMATION_DISPOSAL__RESTORE_PREVIOUS) {
+    memcpy(m_prev_array.get(), m_canvas_array.get(), m_canvas_len);
+  }
+  m_error_message = Composite(slot);
+  if (!m_error_message.empty()) {
+    return m_error_message;
+  }
+  m_frame_config = fc;
+  m_have_frame = true;
+  return "";
+}
+
+std::string  //
+ParallelGifDecoder::DecodeNextBatch() {
+  m_batch_len = 0;
+  m_batch_ri = 0;
+
+  // Scan for the next batch's frame configs. Each decode_frame_config call
+  // skips over the previous frame's LZW-compressed data without
+  // decompressing it. A scanning error is only reported after the frames
+  // before it have been composited.
+  while (m_scan_error_message.empty() && (m_batch_len < m_slots.size())) {
+    wuffs_base__frame_config& fc = m_slots[m_batch_len].frame_config;
+    wuffs_base__status dfc_status =
+        m_scanner->decode_frame_config(&fc, &m_io_buf);
+    if (dfc_status.repr == wuffs_base__note__end_of_data) {
+      m_scan_error_message = ParallelGifDecoder_EndOfAnimation;
+    } else if (dfc_status.repr == wuffs_base__suspension__short_read) {
+      m_scan_error_message = ParallelGifDecoder_UnexpectedEndOfFile;
+    } else if (dfc_status.repr != nullptr) {
+      m_scan_error_message = dfc_status.message();
+    } else {
+      m_batch_len++;
+    }
+  }
+  if (m_batch_len == 0) {
+    return m_scan_error_message;
+  }
+
+  RunTasks(m_batch_len, [this](size_t i) { DecodeSlot(m_slots[i]); });
+  return "";
+}
+
+void  //
+ParallelGifDecoder::DecodeSlot(Slot& slot) {
+  const wuffs_base__frame_config& fc = slot.frame_config;
+  wuffs_base__status rf_status =
+      slot.decoder->restart_frame(fc.index(), fc.io_position());
+  if (!rf_status.is_ok()) {
+    slot.error_message = rf_status.message();
+    return;
+  } else if (fc.io_position() > m_len) {
+    slot.error_message = ParallelGifDecoder_UnexpectedEndOfFile;
+    return;
+  }
+  wuffs_base__io_buffer io_buf =
+      wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(m_ptr), m_len, true);
+  io_buf.meta.ri = (size_t)fc.io_position();
+
+  wuffs_base__status status =
+      slot.decoder->decode_frame_config(nullptr, &io_buf);
+  if (status.repr == nullptr) {
+    status = slot.decoder->decode_frame(&slot.indexes, &io_buf,
+                                        WUFFS_BASE__PIXEL_BLEND__SRC,
+                                        slot.workbuf, nullptr);
+  }
+  if (status.repr == wuffs_base__suspension__short_read) {
+    slot.error_message = ParallelGifDecoder_UnexpectedEndOfFile;
+  } else if (status.repr != nullptr) {
+    slot.error_message = status.message();
+  } else {
+    slot.error_message.clear();
+  }
+}
+
+std::string  //
+ParallelGifDecoder::Composite(Slot& slot) {
+  // This is the same pixel swizzler that the low-level GIF decoder would use
+  // if decoding directly onto the canvas. Like that decoder, it needs some
+  // scratch space for the palette converted to the canvas' pixel format.
+  const wuffs_base__frame_config& fc = slot.frame_config;
+  uint8_t dst_palette_array
+      [WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH];
+  wuffs_base__slice_u8 dst_palette =
+      m_canvas.palette_or_else(wuffs_base__make_slice_u8(
+          dst_palette_array,
+          WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH));
+  wuffs_base__pixel_swizzler swizzler;
+  wuffs_base__status p_status = swizzler.prepare(
+      m_canvas.pixel_format(), dst_palette,
+      slot.indexes.pixel_format(), slot.indexes.palette(),
+      fc.overwrite_instead_of_blend() ? WUFFS_BASE__PIXEL_BLEND__SRC
+                                      : WUFFS_BASE__PIXEL_BLEND__SRC_OVER);
+  if (!p_status.is_ok()) {
+    return p_status.message();
+  }
+
+  wuffs_base__rect_ie_u32 r = fc.bounds();
+  wuffs_base__table_u8 dst_tab = m_canvas.plane(0);
+  wuffs_base__table_u8 src_tab = slot.indexes.plane(0);
+  for (uint32_t y = r.min_incl_y; y < r.max_excl_y; y++) {
+    swizzler.swizzle_interleaved_from_slice(
+        wuffs_base__make_slice_u8(
+            dst_tab.ptr + (y * dst_tab.stride) + (4 * r.min_incl_x),
+            4 * r.width()),
+        dst_palette,
+        wuffs_base__make_slice_u8(
+            src_tab.ptr + (y * src_tab.stride) + r.min_incl_x, r.width()));
+  }
+  return "";
+}
+
+const wuffs_base__image_config&  //
+ParallelGifDecoder::ImageConfig() const {
+  return m_image_config;
+}
+
+const wuffs_base__pixel_buffer&  //
+ParallelGifDecoder::Canvas() const {
+  return m_canvas;
+}
+
+const wuffs_base__frame_config&  //
+ParallelGifDecoder::FrameConfig() const {
+  return m_frame_config;
+}
+
+}  // namespace wuffs_aux
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__AUX__ANIMATION)
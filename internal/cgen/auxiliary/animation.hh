@@ -0,0 +1,281 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// ---------------- Auxiliary - Animation
+
+#include <functional>
+#include <vector>
+
+namespace wuffs_aux {
+
+extern const char AnimationDecoder_BadCallSequence[];
+extern const char AnimationDecoder_EndOfAnimation[];
+extern const char AnimationDecoder_MaxInclDimensionExceeded[];
+extern const char AnimationDecoder_OutOfMemory[];
+extern const char AnimationDecoder_UnexpectedEndOfFile[];
+extern const char AnimationDecoder_UnsupportedImageFormat[];
+extern const char AnimationDecoder_UnsupportedPixelConfiguration[];
+
+extern const char ParallelGifDecoder_BadCallSequence[];
+extern const char ParallelGifDecoder_EndOfAnimation[];
+extern const char ParallelGifDecoder_MaxInclDimensionExceeded[];
+extern const char ParallelGifDecoder_OutOfMemory[];
+extern const char ParallelGifDecoder_UnexpectedEndOfFile[];
+extern const char ParallelGifDecoder_UnsupportedImageFormat[];
+extern const char ParallelGifDecoder_UnsupportedPixelConfiguration[];
+
+// AnimationDecoder decodes the frames of an animated image (e.g. an animated
+// GIF or APNG) and composites them onto a canvas, applying each frame's blend
+// and disposal semantics. Unlike the low-level API (which decodes frames in
+// order), it can also seek to an arbitrary frame.
+//
+// A frame's composited pixels can depend on every earlier frame, so seeking
+// backwards with the low-level API means restarting from frame 0. Instead, as
+// frames are decoded for the first time, AnimationDecoder records keyframes:
+// frame indexes and io_positions that decoding can restart from. Seeking to
+// frame N then only decodes from the nearest keyframe at or before N. There
+// are two kinds of keyframe:
+//  - Frames that do not depend on the canvas' prior contents: frame 0, or a
+//    frame that covers the whole canvas, either is opaque or replaces (instead
+//    of blending over) the canvas and whose disposal is not RESTORE_PREVIOUS.
+//  - Snapshots: a copy of the composited canvas (just before the frame is
+//    decoded), taken every snapshot_interval frames since the last keyframe.
+//
+// Each snapshot costs one canvas' worth of memory (4 bytes per pixel). Their
+// total size is bounded by snapshot_budget: when the next snapshot would
+// exceed it, every second snapshot is dropped and the interval between
+// snapshots is doubled. A zero snapshot_budget disables snapshots, leaving
+// only the first kind of keyframe.
+//
+// The canvas' pixel format is always WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL.
+//
+// The encoded image must be entirely in memory, since seeking re-reads earlier
+// parts of it. The AnimationDecoder does not take responsibility for freeing
+// that memory, which must outlive the AnimationDecoder.
+//
+// The default SelectDecoder accepts these FOURCC codes, subject to the
+// WUFFS_CONFIG__MODULE__FOO macros just like DecodeImageCallbacks:
+//  - WUFFS_BASE__FOURCC__GIF
+//  - WUFFS_BASE__FOURCC__PNG
+//  - WUFFS_BASE__FOURCC__WEBM
+//  - WUFFS_BASE__FOURCC__WEBP
+class AnimationDecoder {
+ public:
+  // DefaultSnapshotBudget is 64 MiB.
+  static constexpr uint64_t DefaultSnapshotBudget = 0x04000000;
+  static constexpr uint64_t DefaultSnapshotInterval = 16;
+
+  AnimationDecoder(const uint8_t* ptr,
+                   size_t len,
+                   uint64_t snapshot_budget = DefaultSnapshotBudget,
+                   uint64_t snapshot_interval = DefaultSnapshotInterval);
+  virtual ~AnimationDecoder();
+
+  // SelectDecoder returns the image decoder for the input data's file format.
+  // Returning a nullptr means failure
+  // (AnimationDecoder_UnsupportedImageFormat). It has the same semantics as
+  // DecodeImageCallbacks::SelectDecoder.
+  virtual wuffs_base__image_decoder::unique_ptr  //
+  SelectDecoder(uint32_t fourcc,
+                wuffs_base__slice_u8 prefix_data,
+                bool prefix_closed);
+
+  // DecodeImageConfig selects the image decoder, decodes the image config and
+  // allocates the canvas. It must be called (and succeed) before SeekFrame.
+  //
+  // It returns an error message, or an empty string on success.
+  std::string  //
+  DecodeImageConfig(const QuirkKeyValuePair* quirks_ptr = nullptr,
+                    size_t quirks_len = 0,
+                    uint32_t max_incl_dimension = 1048575);
+
+  // SeekFrame composites the frames up to and including the frame_index'th
+  // frame onto the canvas. Afterwards, Canvas() holds the pixels to display
+  // and FrameConfig() holds that frame's config (e.g. its duration).
+  //
+  // It returns an error message, or an empty string on success. Seeking past
+  // the last frame returns AnimationDecoder_EndOfAnimation. After any error,
+  // the canvas contents are unspecified until the next successful SeekFrame.
+  std::string  //
+  SeekFrame(uint64_t frame_index);
+
+  const wuffs_base__image_config& ImageConfig() const;
+  const wuffs_base__pixel_buffer& Canvas() const;
+  const wuffs_base__frame_config& FrameConfig() const;
+
+  // NumFramesSeen returns the number of frames whose frame configs have been
+  // decoded so far. It is the total number of frames once
+  // EndOfAnimationSeen() is true.
+  uint64_t NumFramesSeen() const;
+  bool EndOfAnimationSeen() const;
+
+  // NumKeyframes and SnapshotBytes return the current number of keyframes and
+  // the total size of their snapshots.
+  size_t NumKeyframes() const;
+  uint64_t SnapshotBytes() const;
+
+ private:
+  struct Keyframe {
+    uint64_t index;
+    uint64_t io_position;
+    // apng_sequence_number is, for APNG images, the frame's fcTL chunk's
+    // sequence number, which restart_frame cannot derive from the index.
+    uint32_t apng_sequence_number;
+    // snapshot is nullptr for keyframes that do not depend on the canvas'
+    // prior contents.
+    std::unique_ptr<uint8_t[]> snapshot;
+  };
+
+  // NoFrame is the m_frame_index value when the canvas does not hold a fully
+  // composited frame.
+  static constexpr uint64_t NoFrame = UINT64_MAX;
+
+  std::string DecodeNextFrame();
+  void MaybeRecordKeyframe(const wuffs_base__frame_config& fc,
+                           uint32_t apng_sequence_number);
+
+  const uint8_t* m_ptr;
+  const size_t m_len;
+  const uint64_t m_snapshot_budget;
+  uint64_t m_snapshot_interval;
+
+  wuffs_base__image_decoder::unique_ptr m_image_decoder;
+  IOBuffer m_io_buf;
+  wuffs_base__image_config m_image_config;
+  wuffs_base__pixel_buffer m_canvas;
+  size_t m_canvas_len;
+  std::unique_ptr<uint8_t[]> m_canvas_array;
+  std::unique_ptr<uint8_t[]> m_prev_array;
+  std::unique_ptr<uint8_t[]> m_workbuf_array;
+  wuffs_base__slice_u8 m_workbuf;
+
+  wuffs_base__frame_config m_frame_config;
+  uint64_t m_frame_index;
+  uint64_t m_num_frames_seen;
+  bool m_end_of_animation_seen;
+
+  std::vector<Keyframe> m_keyframes;
+  uint64_t m_snapshot_bytes;
+
+  // Delete the copy and assign constructors.
+  AnimationDecoder(const AnimationDecoder&) = delete;
+  AnimationDecoder& operator=(const AnimationDecoder&) = delete;
+};
+
+// ParallelGifDecoder decodes the frames of an animated GIF, in order, and
+// composites them onto a canvas, like AnimationDecoder (but without seeking).
+// It is faster on multi-core machines, as it decompresses several frames
+// concurrently.
+//
+// A GIF frame's LZW-compressed palette indexes do not depend on any earlier
+// frame, only the compositing does. Frame boundaries can be found cheaply,
+// without decompressing anything, as that is what the low-level GIF decoder's
+// decode_frame_config does to skip over a frame that it was not asked to
+// decode. ParallelGifDecoder therefore scans ahead for the next batch of
+// frames and then, given each frame's io_position, decodes each of them (into
+// a per-frame buffer of palette indexes) with its own low-level decoder.
+// Compositing those indexes onto the canvas (via that frame's palette) is
+// serial, but cheap compared to LZW decompression.
+//
+// Each frame in a batch costs 1 byte per canvas pixel (plus a low-level
+// decoder). There are num_threads frames per batch.
+//
+// The canvas' pixel format is always WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL.
+//
+// The encoded image must be entirely in memory, and must outlive the
+// ParallelGifDecoder. It is read concurrently but never written to.
+class ParallelGifDecoder {
+ public:
+  // A zero num_threads means std::thread::hardware_concurrency().
+  ParallelGifDecoder(const uint8_t* ptr, size_t len, uint32_t num_threads = 0);
+  virtual ~ParallelGifDecoder();
+
+  // RunTasks calls task(i), for each i in [0, num_tasks), possibly
+  // concurrently, and returns after every call has returned. Each call
+  // touches a different frame's state.
+  //
+  // The default implementation spreads the calls over up to num_threads
+  // threads (including the calling thread). Override it to use e.g. an
+  // existing thread pool instead.
+  virtual void  //
+  RunTasks(size_t num_tasks, const std::function<void(size_t)>& task);
+
+  // DecodeImageConfig decodes the image config and allocates the canvas. It
+  // must be called (and succeed) before DecodeNextFrame.
+  //
+  // It returns an error message, or an empty string on success.
+  std::string  //
+  DecodeImageConfig(const QuirkKeyValuePair* quirks_ptr = nullptr,
+                    size_t quirks_len = 0,
+                    uint32_t max_incl_dimension = 1048575);
+
+  // DecodeNextFrame composites the next frame onto the canvas. Afterwards,
+  // Canvas() holds the pixels to display and FrameConfig() holds that frame's
+  // config (e.g. its duration).
+  //
+  // It returns an error message, or an empty string on success. After the
+  // last frame, it returns ParallelGifDecoder_EndOfAnimation. Errors are
+  // sticky: once one is returned, every later call returns it too.
+  std::string  //
+  DecodeNextFrame();
+
+  const wuffs_base__image_config& ImageConfig() const;
+  const wuffs_base__pixel_buffer& Canvas() const;
+  const wuffs_base__frame_config& FrameConfig() const;
+
+ private:
+  // A Slot holds one frame of a batch: its low-level decoder and its decoded
+  // palette indexes.
+  struct Slot {
+    wuffs_base__image_decoder::unique_ptr decoder;
+    wuffs_base__pixel_buffer indexes;
+    std::unique_ptr<uint8_t[]> indexes_array;
+    std::unique_ptr<uint8_t[]> palette_array;
+    std::unique_ptr<uint8_t[]> workbuf_array;
+    wuffs_base__slice_u8 workbuf;
+    wuffs_base__frame_config frame_config;
+    std::string error_message;
+
+    Slot();
+  };
+
+  std::string DecodeNextBatch();
+  void DecodeSlot(Slot& slot);
+  std::string Composite(Slot& slot);
+
+  const uint8_t* m_ptr;
+  const size_t m_len;
+  const uint32_t m_num_threads;
+
+  // m_scanner finds the frame boundaries. It decodes frame configs but never
+  // frames.
+  wuffs_base__image_decoder::unique_ptr m_scanner;
+  IOBuffer m_io_buf;
+  wuffs_base__image_config m_image_config;
+  wuffs_base__pixel_buffer m_canvas;
+  size_t m_canvas_len;
+  std::unique_ptr<uint8_t[]> m_canvas_array;
+  std::unique_ptr<uint8_t[]> m_prev_array;
+
+  std::vector<Slot> m_slots;
+  size_t m_batch_len;
+  size_t m_batch_ri;
+  std::string m_scan_error_message;
+  std::string m_error_message;
+
+  wuffs_base__frame_config m_frame_config;
+  bool m_have_frame;
+
+  // Delete the copy and assign constructors.
+  ParallelGifDecoder(const ParallelGifDecoder&) = delete;
+  ParallelGifDecoder& operator=(const ParallelGifDecoder&) = delete;
+};
+
+}  // namespace wuffs_aux
@@ -92,6 +92,11 @@ Input::BringsItsOwnIOBuffer() {
   return nullptr;
 }
 
+std::string  //
+Input::Seek(IOBuffer* dst, uint64_t absolute_position) {
+  return "wuffs_aux::sync_io::Input: unsupported seek";
+}
+
 // --------
 
 FileInput::FileInput(FILE* f) : m_f(f) {}
@@ -116,6 +121,30 @@ FileInput::CopyIn(IOBuffer* dst) {
   return "";
 }
 
+std::string  //
+FileInput::Seek(IOBuffer* dst, uint64_t absolute_position) {
+  if (!m_f) {
+    return "wuffs_aux::sync_io::FileInput: nullptr file";
+  } else if (!dst) {
+    return "wuffs_aux::sync_io::FileInput: nullptr IOBuffer";
+  }
+  // The file's current offset corresponds to the end of dst's written bytes.
+  // Seeking relative to that (instead of to the start of the file) means that
+  // the input need not start at the start of the file.
+  uint64_t current_position = dst->meta.pos + dst->meta.wi;
+  int64_t delta = (int64_t)(absolute_position - current_position);
+  if ((delta < LONG_MIN) || (LONG_MAX < delta)) {
+    return "wuffs_aux::sync_io::FileInput: unsupported seek";
+  } else if (fseek(m_f, (long)delta, SEEK_CUR) != 0) {
+    return "wuffs_aux::sync_io::FileInput: error seeking file";
+  }
+  dst->meta.wi = 0;
+  dst->meta.ri = 0;
+  dst->meta.pos = absolute_position;
+  dst->meta.closed = false;
+  return "";
+}
+
 // --------
 
 MemoryInput::MemoryInput(const char* ptr, size_t len)
@@ -206,6 +235,27 @@ AdvanceIOBufferTo(const ErrorMessages& error_messages,
   return "";
 }
 
+// SeekIOBufferTo is like AdvanceIOBufferTo but it can also go backwards and,
+// when absolute_position is not within io_buf's buffered bytes, it prefers
+// calling input.Seek over reading (and discarding) the bytes in between.
+std::string  //
+SeekIOBufferTo(const ErrorMessages& error_messages,
+               sync_io::Input& input,
+               IOBuffer& io_buf,
+               uint64_t absolute_position) {
+  uint64_t buffered_min_incl = io_buf.meta.pos;
+  uint64_t buffered_max_incl = io_buf.meta.pos + io_buf.meta.wi;
+  if ((buffered_min_incl <= absolute_position) &&
+      (absolute_position <= buffered_max_incl)) {
+    io_buf.meta.ri = (size_t)(absolute_position - buffered_min_incl);
+    return "";
+  } else if (!input.BringsItsOwnIOBuffer() &&
+             input.Seek(&io_buf, absolute_position).empty()) {
+    return "";
+  }
+  return AdvanceIOBufferTo(error_messages, input, io_buf, absolute_position);
+}
+
 std::string  //
 HandleMetadata(
     const ErrorMessages& error_messages,
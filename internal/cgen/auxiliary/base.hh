@@ -13,6 +13,7 @@
 // Auxiliary code is discussed at
 // https://github.com/google/wuffs/blob/main/doc/note/auxiliary-code.md
 
+#include <limits.h>
 #include <stdio.h>
 
 #include <string>
@@ -98,6 +99,15 @@ class Input {
 
   virtual IOBuffer* BringsItsOwnIOBuffer();
   virtual std::string CopyIn(IOBuffer* dst) = 0;
+
+  // Seek repositions the input so that the next CopyIn call copies in the
+  // bytes starting at absolute_position (an io_position, relative to the
+  // start of the input). It discards dst's buffered contents. It returns an
+  // error message, or an empty string on success.
+  //
+  // The default implementation always returns an error, as not every input
+  // (e.g. a network stream) is seekable.
+  virtual std::string Seek(IOBuffer* dst, uint64_t absolute_position);
 };
 
 // --------
@@ -110,6 +120,7 @@ class FileInput : public Input {
   FileInput(FILE* f);
 
   virtual std::string CopyIn(IOBuffer* dst);
+  virtual std::string Seek(IOBuffer* dst, uint64_t absolute_position);
 
  private:
   FILE* m_f;
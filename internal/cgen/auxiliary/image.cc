@@ -12,8 +12,18 @@
 
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__IMAGE)
 
+#include <memory>
 #include <utility>
 
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ETC2) || \
+    defined(WUFFS_CONFIG__MODULE__JPEG) ||                                    \
+    defined(WUFFS_CONFIG__MODULE__PNG) || defined(WUFFS_CONFIG__MODULE__WEBP)
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
 namespace wuffs_aux {
 
 DecodeImageResult::DecodeImageResult(MemOwner&& pixbuf_mem_owner0,
@@ -121,6 +131,11 @@ DecodeImageCallbacks::SelectDecoder(uint32_t fourcc,
       return wuffs_wbmp__decoder::alloc_as__wuffs_base__image_decoder();
 #endif
 
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBM)
+    case WUFFS_BASE__FOURCC__WEBM:
+      return wuffs_webm__decoder::alloc_as__wuffs_base__image_decoder();
+#endif
+
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
     case WUFFS_BASE__FOURCC__WEBP:
       return wuffs_webp__decoder::alloc_as__wuffs_base__image_decoder();
@@ -304,6 +319,23 @@ DIHM1(void* self,
   return static_cast<DecodeImageCallbacks*>(self)->HandleMetadata(*minfo, raw);
 }
 
+std::string  //
+DecodeImageSeek(wuffs_base__image_decoder::unique_ptr& image_decoder,
+                sync_io::Input& input,
+                wuffs_base__io_buffer& io_buf) {
+  wuffs_base__io_buffer empty = wuffs_base__empty_io_buffer();
+  wuffs_base__more_information minfo = wuffs_base__empty_more_information();
+  wuffs_base__status tmm_status =
+      image_decoder->tell_me_more(&empty, &minfo, &io_buf);
+  if (tmm_status.repr != nullptr) {
+    return tmm_status.message();
+  } else if (minfo.flavor != WUFFS_BASE__MORE_INFORMATION__FLAVOR__IO_SEEK) {
+    return DecodeImage_UnsupportedImageFormat;
+  }
+  return private_impl::SeekIOBufferTo(DecodeImageErrorMessages, input, io_buf,
+                                      minfo.io_seek__position());
+}
+
 std::string  //
 DecodeImageHandleMetadata(wuffs_base__image_decoder::unique_ptr& image_decoder,
                           DecodeImageCallbacks& callbacks,
@@ -316,6 +348,462 @@ DecodeImageHandleMetadata(wuffs_base__image_decoder::unique_ptr& image_decoder,
                                       DIHM1, static_cast<void*>(&callbacks));
 }
 
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ETC2) || \
+    defined(WUFFS_CONFIG__MODULE__JPEG) ||                                    \
+    defined(WUFFS_CONFIG__MODULE__PNG) || defined(WUFFS_CONFIG__MODULE__WEBP)
+
+// DecodeImageIsA returns whether image_decoder's concrete type is the one
+// whose wuffs_base__image_decoder function pointers are func_ptrs. A custom
+// SelectDecoder can return some other implementation for a given fourcc, so
+// check this before downcasting.
+bool  //
+DecodeImageIsA(wuffs_base__image_decoder* image_decoder,
+               const wuffs_base__image_decoder__func_ptrs* func_ptrs) {
+  return image_decoder &&
+         (image_decoder->private_impl.first_vtable.vtable_name ==
+          wuffs_base__image_decoder__vtable_name) &&
+         (image_decoder->private_impl.first_vtable.function_pointers ==
+          static_cast<const void*>(func_ptrs));
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__ETC2) ||
+        // defined(WUFFS_CONFIG__MODULE__JPEG) ||
+        // defined(WUFFS_CONFIG__MODULE__PNG) ||
+        // defined(WUFFS_CONFIG__MODULE__WEBP)
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+
+// DecodeImageLoopFilterThread loop-filters a lossy WebP image's macroblock
+// rows on a background thread, for DecodeImageArgFlags::PIPELINE_LOOP_FILTER.
+// It owns the WUFFS_VP8__QUIRK_DEFER_LOOP_FILTER delegate that does the
+// filtering, so that the background thread never touches the decoder that is
+// still decoding. The n'th Request call is for the n'th macroblock row.
+class DecodeImageLoopFilterThread {
+ public:
+  explicit DecodeImageLoopFilterThread(wuffs_base__slice_u8 workbuf)
+      : m_workbuf(workbuf),
+        m_num_requested(0),
+        m_num_finished(0),
+        m_quit(false) {}
+
+  // The destructor finishes any outstanding request before returning.
+  ~DecodeImageLoopFilterThread() {
+    if (!m_thread.joinable()) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_quit = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+
+  // Start attaches the delegate to the work buffer, which the decoder has
+  // filled in by its first "$loop filter row ready" suspension, and starts the
+  // background thread. It returns an error message, or an empty string on
+  // success.
+  std::string Start(uint32_t width, uint32_t height) {
+    m_delegate = wuffs_vp8__decoder::alloc();
+    if (!m_delegate) {
+      return DecodeImage_OutOfMemory;
+    }
+    wuffs_base__status status =
+        m_delegate->attach_delegate(m_workbuf, width, height, 0);
+    if (!status.is_ok()) {
+      return status.message();
+    }
+    m_thread = std::thread(&DecodeImageLoopFilterThread::Loop, this);
+    return "";
+  }
+
+  // Request waits for the previous row's filtering to finish (the
+  // QUIRK_DEFER_LOOP_FILTER contract allows only one row in flight) and then
+  // starts filtering the next row, without waiting for it to finish.
+  void Request() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cond.wait(lock, [this] { return m_num_finished == m_num_requested; });
+    m_num_requested++;
+    m_cond.notify_all();
+  }
+
+ private:
+  void Loop() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true) {
+      m_cond.wait(lock, [this] {
+        return m_quit || (m_num_finished < m_num_requested);
+      });
+      if (m_num_finished == m_num_requested) {
+        return;
+      }
+      uint32_t mby = m_num_finished;
+      lock.unlock();
+      m_delegate->loop_filter_row(m_workbuf, mby);
+      lock.lock();
+      m_num_finished++;
+      m_cond.notify_all();
+    }
+  }
+
+  wuffs_base__slice_u8 m_workbuf;
+  wuffs_vp8__decoder::unique_ptr m_delegate;
+  uint32_t m_num_requested;
+  uint32_t m_num_finished;
+  bool m_quit;
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+  std::thread m_thread;
+};
+
+// DecodeImageWavefront decodes a lossy WebP image's macroblock rows, for
+// DecodeImageArgFlags::WAVEFRONT_MACROBLOCK_ROWS, via one
+// WUFFS_VP8__QUIRK_DELEGATE_MACROBLOCK_ROWS delegate per token partition. The
+// p'th of n delegates decodes (and loop-filters) rows p, (p + n), (p + 2n),
+// etc. Delegate 0 runs on the calling thread and the others on their own.
+class DecodeImageWavefront {
+ public:
+  DecodeImageWavefront(wuffs_base__slice_u8 workbuf,
+                       uint32_t width,
+                       uint32_t height)
+      : m_workbuf(workbuf),
+        m_width(width),
+        m_height(height),
+        m_mbw((width + 15) / 16),
+        m_mbh((height + 15) / 16),
+        m_num_decoded(m_mbh, 0),
+        m_num_filtered(0) {}
+
+  // Run returns after every row is decoded and filtered (or after an error).
+  // It returns an error message, or an empty string on success.
+  std::string Run(uint32_t num_delegates) {
+    for (uint32_t p = 0; p < num_delegates; p++) {
+      m_delegates.push_back(wuffs_vp8__decoder::alloc());
+      if (!m_delegates.back()) {
+        return DecodeImage_OutOfMemory;
+      }
+      wuffs_base__status status = m_delegates.back()->attach_delegate(
+          m_workbuf, m_width, m_height, p);
+      if (!status.is_ok()) {
+        return status.message();
+      }
+    }
+
+    std::vector<std::thread> threads;
+    for (uint32_t p = 1; p < num_delegates; p++) {
+      threads.emplace_back(&DecodeImageWavefront::Loop, this, p);
+    }
+    Loop(0);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    return m_error_message;
+  }
+
+ private:
+  void Loop(uint32_t p) {
+    wuffs_vp8__decoder* delegate = m_delegates[p].get();
+    const uint32_t n = static_cast<uint32_t>(m_delegates.size());
+    for (uint32_t mby = p; mby < m_mbh; mby += n) {
+      uint32_t mbx = 0;
+      while (mbx < m_mbw) {
+        // Wait for the row above to be two macroblocks ahead (or finished).
+        uint32_t mbx_end = m_mbw;
+        if (mby > 0) {
+          std::unique_lock<std::mutex> lock(m_mutex);
+          m_cond.wait(lock, [this, mby, mbx] {
+            uint32_t above = m_num_decoded[mby - 1];
+            return !m_error_message.empty() || (above == m_mbw) ||
+                   (above > (mbx + 1));
+          });
+          if (!m_error_message.empty()) {
+            return;
+          }
+          uint32_t above = m_num_decoded[mby - 1];
+          mbx_end = (above == m_mbw) ? m_mbw : (above - 1);
+        }
+
+        wuffs_base__status status =
+            delegate->decode_delegated_macroblocks(m_workbuf, mby, mbx_end);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!status.is_ok()) {
+          if (m_error_message.empty()) {
+            m_error_message = status.message();
+          }
+          m_cond.notify_all();
+          return;
+        }
+        m_num_decoded[mby] = mbx_end;
+        m_cond.notify_all();
+        mbx = mbx_end;
+      }
+
+      // Row (mby - 1) can be filtered now that row mby is decoded. The final
+      // row can be filtered straight away.
+      if ((mby > 0) && !Filter(delegate, mby - 1)) {
+        return;
+      } else if (((mby + 1) == m_mbh) && !Filter(delegate, mby)) {
+        return;
+      }
+    }
+  }
+
+  // Filter waits for the rows before mby to be filtered, then filters row
+  // mby. It returns false if some other delegate hit an error.
+  bool Filter(wuffs_vp8__decoder* delegate, uint32_t mby) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cond.wait(lock, [this, mby] {
+        return !m_error_message.empty() || (m_num_filtered == mby);
+      });
+      if (!m_error_message.empty()) {
+        return false;
+      }
+    }
+    delegate->loop_filter_row(m_workbuf, mby);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_num_filtered++;
+    m_cond.notify_all();
+    return true;
+  }
+
+  wuffs_base__slice_u8 m_workbuf;
+  const uint32_t m_width;
+  const uint32_t m_height;
+  const uint32_t m_mbw;
+  const uint32_t m_mbh;
+  std::vector<wuffs_vp8__decoder::unique_ptr> m_delegates;
+  std::vector<uint32_t> m_num_decoded;
+  uint32_t m_num_filtered;
+  std::string m_error_message;
+  std::mutex m_mutex;
+  std::condition_variable m_cond;
+};
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__WEBP)
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ETC2)
+
+// DecodeImageBlockRows decodes an ETC2 image's block rows in the half-open
+// range [min_incl_block_row .. max_excl_block_row). The io_buf is passed by
+// value, so that concurrent calls can share its (read-only) data. It returns
+// an error message, or an empty string on success.
+std::string  //
+DecodeImageBlockRows(wuffs_etc2__decoder* etc2_decoder,
+                     wuffs_base__pixel_buffer* pixel_buffer,
+                     wuffs_base__io_buffer io_buf,
+                     wuffs_base__pixel_blend pixel_blend,
+                     uint32_t min_incl_block_row,
+                     uint32_t max_excl_block_row) {
+  io_buf.meta.ri = static_cast<size_t>(
+      etc2_decoder->block_row_io_position(min_incl_block_row));
+  wuffs_base__status status = etc2_decoder->decode_block_rows(
+      pixel_buffer, &io_buf, pixel_blend, min_incl_block_row,
+      max_excl_block_row);
+  return status.is_ok() ? "" : status.message();
+}
+
+// DecodeImageParallelBlockRows decodes an ETC2 image, for
+// DecodeImageArgFlags::PARALLEL_BLOCK_ROWS, as num_bands equal-ish bands of
+// block rows. The first band is decoded by etc2_decoder on the calling thread
+// and the others by their own wuffs_etc2__decoder on their own thread.
+//
+// The io_buf must hold the whole file, starting at I/O position 0.
+std::string  //
+DecodeImageParallelBlockRows(wuffs_etc2__decoder* etc2_decoder,
+                             wuffs_base__pixel_buffer* pixel_buffer,
+                             const wuffs_base__io_buffer& io_buf,
+                             wuffs_base__pixel_blend pixel_blend,
+                             uint32_t num_bands) {
+  const uint64_t num_block_rows = etc2_decoder->num_block_rows();
+  std::vector<std::string> error_messages(num_bands);
+  std::vector<std::thread> threads;
+  for (uint32_t b = 1; b < num_bands; b++) {
+    threads.emplace_back([=, &io_buf, &error_messages] {
+      wuffs_etc2__decoder::unique_ptr band_decoder =
+          wuffs_etc2__decoder::alloc();
+      if (!band_decoder) {
+        error_messages[b] = DecodeImage_OutOfMemory;
+        return;
+      }
+      wuffs_base__io_buffer header = io_buf;
+      header.meta.ri = 0;
+      wuffs_base__status status =
+          band_decoder->decode_image_config(nullptr, &header);
+      if (!status.is_ok()) {
+        error_messages[b] = status.message();
+        return;
+      }
+      error_messages[b] = DecodeImageBlockRows(
+          band_decoder.get(), pixel_buffer, io_buf, pixel_blend,
+          static_cast<uint32_t>((num_block_rows * b) / num_bands),
+          static_cast<uint32_t>((num_block_rows * (b + 1)) / num_bands));
+    });
+  }
+  error_messages[0] = DecodeImageBlockRows(
+      etc2_decoder, pixel_buffer, io_buf, pixel_blend, 0,
+      static_cast<uint32_t>(num_block_rows / num_bands));
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& error_message : error_messages) {
+    if (!error_message.empty()) {
+      return error_message;
+    }
+  }
+  return "";
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__ETC2)
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+
+// DecodeImageStrip decodes one of a PNG image's iDOT strips with its own
+// wuffs_png__decoder. The io_buf is passed by value, so that concurrent calls
+// can share its (read-only) data. It returns an error message, or an empty
+// string on success, in which case it sets *final_ri to the I/O buffer's
+// final read index.
+std::string  //
+DecodeImageStrip(wuffs_base__pixel_buffer* pixel_buffer,
+                 wuffs_base__io_buffer io_buf,
+                 wuffs_base__pixel_blend pixel_blend,
+                 wuffs_base__slice_u8 workbuf,
+                 const QuirkKeyValuePair* quirks_ptr,
+                 const size_t quirks_len,
+                 uint32_t strip,
+                 size_t* final_ri) {
+  wuffs_png__decoder::unique_ptr strip_decoder = wuffs_png__decoder::alloc();
+  if (!strip_decoder) {
+    return DecodeImage_OutOfMemory;
+  }
+  for (size_t i = 0; i < quirks_len; i++) {
+    strip_decoder->set_quirk(quirks_ptr[i].first, quirks_ptr[i].second);
+  }
+  io_buf.meta.ri = 0;
+  wuffs_base__status status =
+      strip_decoder->decode_image_config(nullptr, &io_buf);
+  if (!status.is_ok()) {
+    return status.message();
+  }
+  // An out-of-range subslice is empty, which decode_strip rejects.
+  wuffs_base__range_ie_u64 r = strip_decoder->strip_workbuf_range(strip);
+  io_buf.meta.ri =
+      static_cast<size_t>(strip_decoder->strip_io_position(strip));
+  status = strip_decoder->decode_strip(
+      pixel_buffer, &io_buf, pixel_blend,
+      wuffs_base__slice_u8__subslice_ij(workbuf, r.min_incl, r.max_excl),
+      strip);
+  if (!status.is_ok()) {
+    return status.message();
+  }
+  *final_ri = io_buf.meta.ri;
+  return "";
+}
+
+// DecodeImageParallelStrips decodes a PNG image, for
+// DecodeImageArgFlags::PARALLEL_STRIPS, one iDOT strip per thread. The first
+// strip is decoded on the calling thread. Every strip gets its own
+// wuffs_png__decoder, leaving png_decoder free to decode the whole image
+// (serially) if this fails.
+//
+// The io_buf must hold the whole file, starting at I/O position 0. On success,
+// its read index is advanced past the last strip's IDAT chunks and png_decoder
+// carries on as if it had decoded the frame itself.
+std::string  //
+DecodeImageParallelStrips(wuffs_png__decoder* png_decoder,
+                          wuffs_base__pixel_buffer* pixel_buffer,
+                          wuffs_base__io_buffer& io_buf,
+                          wuffs_base__pixel_blend pixel_blend,
+                          wuffs_base__slice_u8 workbuf,
+                          const QuirkKeyValuePair* quirks_ptr,
+                          const size_t quirks_len) {
+  const uint32_t num_strips = png_decoder->num_strips();
+  std::vector<std::string> error_messages(num_strips);
+  std::vector<size_t> final_ris(num_strips);
+  std::vector<std::thread> threads;
+  for (uint32_t s = 1; s < num_strips; s++) {
+    threads.emplace_back([=, &io_buf, &error_messages, &final_ris] {
+      error_messages[s] =
+          DecodeImageStrip(pixel_buffer, io_buf, pixel_blend, workbuf,
+                           quirks_ptr, quirks_len, s, &final_ris[s]);
+    });
+  }
+  error_messages[0] =
+      DecodeImageStrip(pixel_buffer, io_buf, pixel_blend, workbuf,
+                       quirks_ptr, quirks_len, 0, &final_ris[0]);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& error_message : error_messages) {
+    if (!error_message.empty()) {
+      return error_message;
+    }
+  }
+  wuffs_base__status status = png_decoder->finish_strips();
+  if (!status.is_ok()) {
+    return status.message();
+  }
+  io_buf.meta.ri = final_ris[num_strips - 1];
+  return "";
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__PNG)
+
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JPEG)
+
+// DecodeImageParallelIdct applies a JPEG image's IDCT, for
+// DecodeImageArgFlags::PARALLEL_IDCT, as num_bands equal-ish bands of MCU
+// rows. Each band has its own WUFFS_JPEG__QUIRK_DELEGATE_IDCT delegate. The
+// first band runs on the calling thread and the others on their own.
+std::string  //
+DecodeImageParallelIdct(wuffs_base__slice_u8 workbuf,
+                        uint32_t num_mcu_rows,
+                        uint32_t num_bands) {
+  std::vector<std::string> error_messages(num_bands);
+  auto band = [=, &error_messages](uint32_t b) {
+    wuffs_jpeg__decoder::unique_ptr delegate = wuffs_jpeg__decoder::alloc();
+    if (!delegate) {
+      error_messages[b] = DecodeImage_OutOfMemory;
+      return;
+    }
+    wuffs_base__status status = delegate->attach_delegate(workbuf);
+    if (status.is_ok()) {
+      uint64_t n = num_mcu_rows;
+      status = delegate->decode_delegated_idct(
+          workbuf, static_cast<uint32_t>((n * b) / num_bands),
+          static_cast<uint32_t>((n * (b + 1)) / num_bands));
+    }
+    if (!status.is_ok()) {
+      error_messages[b] = status.message();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (uint32_t b = 1; b < num_bands; b++) {
+    threads.emplace_back(band, b);
+  }
+  band(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto& error_message : error_messages) {
+    if (!error_message.empty()) {
+      return error_message;
+    }
+  }
+  return "";
+}
+
+#endif  // !defined(WUFFS_CONFIG__MODULES) ||
+        // defined(WUFFS_CONFIG__MODULE__JPEG)
+
 DecodeImageResult  //
 DecodeImage0(wuffs_base__image_decoder::unique_ptr& image_decoder,
              DecodeImageCallbacks& callbacks,
@@ -341,8 +829,22 @@ DecodeImage0(wuffs_base__image_decoder::unique_ptr& image_decoder,
   sync_io::DynIOBuffer raw_metadata_buf(max_incl_metadata_length);
   uint64_t start_pos = io_buf.reader_position();
   bool interested_in_metadata_after_the_frame = false;
+  bool skip_pixel_data = (flags & DecodeImageArgFlags::SKIP_PIXEL_DATA) != 0;
   bool redirected = false;
   int32_t fourcc = 0;
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ETC2)
+  wuffs_etc2__decoder* parallel_etc2_decoder = nullptr;
+#endif
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JPEG)
+  wuffs_jpeg__decoder* parallel_jpeg_decoder = nullptr;
+#endif
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+  wuffs_png__decoder* parallel_png_decoder = nullptr;
+#endif
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+  bool pipelined_webp_decoder = false;
+  wuffs_webp__decoder* wavefront_webp_decoder = nullptr;
+#endif
 redirect:
   do {
     // Determine the image format.
@@ -435,6 +937,68 @@ redirect:
         interested_in_metadata_after_the_frame = true;
         image_decoder->set_report_metadata(WUFFS_BASE__FOURCC__XMP, true);
       }
+      if (skip_pixel_data) {
+        image_decoder->set_quirk(WUFFS_BASE__QUIRK_SEEK_PAST_PIXEL_DATA, 1);
+      }
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ETC2)
+      parallel_etc2_decoder = nullptr;
+      if ((flags & DecodeImageArgFlags::PARALLEL_BLOCK_ROWS) &&
+          (fourcc == WUFFS_BASE__FOURCC__ETC2) &&
+          DecodeImageIsA(
+              image_decoder.get(),
+              &wuffs_etc2__decoder__func_ptrs_for__wuffs_base__image_decoder)) {
+        parallel_etc2_decoder =
+            reinterpret_cast<wuffs_etc2__decoder*>(image_decoder.get());
+      }
+#endif
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JPEG)
+      parallel_jpeg_decoder = nullptr;
+      if ((flags & DecodeImageArgFlags::PARALLEL_IDCT) &&
+          (fourcc == WUFFS_BASE__FOURCC__JPEG) &&
+          (std::thread::hardware_concurrency() > 1) &&
+          DecodeImageIsA(
+              image_decoder.get(),
+              &wuffs_jpeg__decoder__func_ptrs_for__wuffs_base__image_decoder) &&
+          image_decoder->set_quirk(WUFFS_JPEG__QUIRK_DELEGATE_IDCT, 1)
+              .is_ok()) {
+        parallel_jpeg_decoder =
+            reinterpret_cast<wuffs_jpeg__decoder*>(image_decoder.get());
+      }
+#endif
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+      parallel_png_decoder = nullptr;
+      if ((flags & DecodeImageArgFlags::PARALLEL_STRIPS) &&
+          (fourcc == WUFFS_BASE__FOURCC__PNG) &&
+          (std::thread::hardware_concurrency() > 1) &&
+          DecodeImageIsA(
+              image_decoder.get(),
+              &wuffs_png__decoder__func_ptrs_for__wuffs_base__image_decoder)) {
+        parallel_png_decoder =
+            reinterpret_cast<wuffs_png__decoder*>(image_decoder.get());
+      }
+#endif
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+      pipelined_webp_decoder =
+          (flags & DecodeImageArgFlags::PIPELINE_LOOP_FILTER) &&
+          (fourcc == WUFFS_BASE__FOURCC__WEBP) &&
+          DecodeImageIsA(
+              image_decoder.get(),
+              &wuffs_webp__decoder__func_ptrs_for__wuffs_base__image_decoder) &&
+          image_decoder->set_quirk(WUFFS_VP8__QUIRK_DEFER_LOOP_FILTER, 1)
+              .is_ok();
+      wavefront_webp_decoder = nullptr;
+      if ((flags & DecodeImageArgFlags::WAVEFRONT_MACROBLOCK_ROWS) &&
+          (fourcc == WUFFS_BASE__FOURCC__WEBP) &&
+          DecodeImageIsA(
+              image_decoder.get(),
+              &wuffs_webp__decoder__func_ptrs_for__wuffs_base__image_decoder) &&
+          image_decoder
+              ->set_quirk(WUFFS_VP8__QUIRK_DELEGATE_MACROBLOCK_ROWS, 1)
+              .is_ok()) {
+        wavefront_webp_decoder =
+            reinterpret_cast<wuffs_webp__decoder*>(image_decoder.get());
+      }
+#endif
     }
 
     // Decode the image config.
@@ -497,11 +1061,19 @@ redirect:
                             WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, w, h);
   }
 
-  // Allocate the pixel buffer.
+  // Allocate the pixel buffer. When skipping the pixel data, the pixel buffer
+  // has a valid pixcfg but no pixels.
   bool valid_background_color =
+      !skip_pixel_data &&
       wuffs_base__color_u32_argb_premul__is_valid(background_color);
+  wuffs_base__pixel_buffer skipped_pixel_buffer =
+      wuffs_base__null_pixel_buffer();
+  skipped_pixel_buffer.pixcfg = image_config.pixcfg;
   DecodeImageCallbacks::AllocPixbufResult alloc_pixbuf_result =
-      callbacks.AllocPixbuf(image_config, valid_background_color);
+      skip_pixel_data ? DecodeImageCallbacks::AllocPixbufResult(
+                            MemOwner(nullptr, &free), skipped_pixel_buffer)
+                      : callbacks.AllocPixbuf(image_config,
+                                              valid_background_color);
   if (!alloc_pixbuf_result.error_message.empty()) {
     return DecodeImageResult(std::move(alloc_pixbuf_result.error_message));
   }
@@ -516,9 +1088,14 @@ redirect:
 
   // Allocate the work buffer. Wuffs' decoders conventionally assume that this
   // can be uninitialized memory.
-  wuffs_base__range_ii_u64 workbuf_len = image_decoder->workbuf_len();
+  wuffs_base__range_ii_u64 workbuf_len =
+      skip_pixel_data ? wuffs_base__empty_range_ii_u64()
+                      : image_decoder->workbuf_len();
   DecodeImageCallbacks::AllocWorkbufResult alloc_workbuf_result =
-      callbacks.AllocWorkbuf(workbuf_len, true);
+      skip_pixel_data
+          ? DecodeImageCallbacks::AllocWorkbufResult(
+                MemOwner(nullptr, &free), wuffs_base__empty_slice_u8())
+          : callbacks.AllocWorkbuf(workbuf_len, true);
   if (!alloc_workbuf_result.error_message.empty()) {
     return DecodeImageResult(std::move(alloc_workbuf_result.error_message));
   } else if (alloc_workbuf_result.workbuf.len < workbuf_len.min_incl) {
@@ -559,12 +1136,114 @@ redirect:
       frame_config.overwrite_instead_of_blend()) {
     pixel_blend = WUFFS_BASE__PIXEL_BLEND__SRC;
   }
-  while (true) {
+  bool decode_serially = !skip_pixel_data;
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__ETC2)
+  // Decoding in parallel needs every band's data up front. With a 16 byte
+  // header, the I/O buffer should be positioned at the first block row.
+  if (parallel_etc2_decoder && decode_serially && (io_buf.meta.pos == 0) &&
+      (io_buf.meta.ri == 16) &&
+      (io_buf.meta.wi >=
+       parallel_etc2_decoder->block_row_io_position(
+           parallel_etc2_decoder->num_block_rows()))) {
+    // Have each band be at least 16 block rows (64 pixel rows) high.
+    uint32_t num_bands = std::thread::hardware_concurrency();
+    uint32_t max_num_bands = parallel_etc2_decoder->num_block_rows() / 16;
+    if (num_bands > max_num_bands) {
+      num_bands = max_num_bands;
+    }
+    if (num_bands > 1) {
+      decode_serially = false;
+      message = DecodeImageParallelBlockRows(parallel_etc2_decoder,
+                                             &pixel_buffer, io_buf,
+                                             pixel_blend, num_bands);
+      if (message.empty()) {
+        io_buf.meta.ri = static_cast<size_t>(
+            parallel_etc2_decoder->block_row_io_position(
+                parallel_etc2_decoder->num_block_rows()));
+      }
+    }
+  }
+#endif
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__PNG)
+  // Decoding in parallel needs every strip's data up front. The I/O buffer
+  // should be positioned at the first strip's first IDAT chunk. Sharing the
+  // dst palette between threads would race, so indexed formats are excluded.
+  //
+  // On failure (e.g. a strip whose first row is filtered relative to the
+  // previous strip's last row), image_decoder's frame is still undecoded, so
+  // we fall back to decoding serially, overwriting any partial pixels.
+  if (parallel_png_decoder && decode_serially &&
+      (pixel_blend == WUFFS_BASE__PIXEL_BLEND__SRC) &&
+      !pixel_buffer.pixcfg.pixel_format().is_indexed() &&
+      (parallel_png_decoder->num_strips() > 1) && (io_buf.meta.pos == 0) &&
+      io_buf.meta.closed &&
+      (io_buf.meta.ri == parallel_png_decoder->strip_io_position(0))) {
+    std::string error_message = DecodeImageParallelStrips(
+        parallel_png_decoder, &pixel_buffer, io_buf, pixel_blend,
+        alloc_workbuf_result.workbuf, quirks_ptr, quirks_len);
+    decode_serially = !error_message.empty();
+  }
+#endif
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+  std::unique_ptr<DecodeImageLoopFilterThread> loop_filter_thread;
+#endif
+  while (decode_serially) {
     wuffs_base__status id_df_status =
         image_decoder->decode_frame(&pixel_buffer, &io_buf, pixel_blend,
                                     alloc_workbuf_result.workbuf, nullptr);
     if (id_df_status.repr == nullptr) {
       break;
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__JPEG)
+    } else if (parallel_jpeg_decoder &&
+               (id_df_status.repr ==
+                wuffs_jpeg__suspension__idct_rows_ready)) {
+      // Have each band be at least 4 MCU rows high.
+      uint32_t num_mcu_rows =
+          wuffs_jpeg__decoder__num_mcu_rows(parallel_jpeg_decoder);
+      uint32_t num_bands = std::thread::hardware_concurrency();
+      if (num_bands > (num_mcu_rows / 4)) {
+        num_bands = num_mcu_rows / 4;
+      }
+      std::string error_message = DecodeImageParallelIdct(
+          alloc_workbuf_result.workbuf, num_mcu_rows,
+          (num_bands > 1) ? num_bands : 1);
+      if (!error_message.empty()) {
+        message = std::move(error_message);
+        break;
+      }
+      continue;
+#endif
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+    } else if (pipelined_webp_decoder &&
+               (id_df_status.repr ==
+                wuffs_vp8__suspension__loop_filter_row_ready)) {
+      if (!loop_filter_thread) {
+        loop_filter_thread.reset(
+            new DecodeImageLoopFilterThread(alloc_workbuf_result.workbuf));
+        std::string error_message =
+            loop_filter_thread->Start(pixel_buffer.pixcfg.width(),
+                                      pixel_buffer.pixcfg.height());
+        if (!error_message.empty()) {
+          message = std::move(error_message);
+          break;
+        }
+      }
+      loop_filter_thread->Request();
+      continue;
+    } else if (wavefront_webp_decoder &&
+               (id_df_status.repr ==
+                wuffs_vp8__suspension__macroblock_rows_ready)) {
+      DecodeImageWavefront wavefront(alloc_workbuf_result.workbuf,
+                                     pixel_buffer.pixcfg.width(),
+                                     pixel_buffer.pixcfg.height());
+      std::string error_message = wavefront.Run(
+          wuffs_webp__decoder__num_token_partitions(wavefront_webp_decoder));
+      if (!error_message.empty()) {
+        message = std::move(error_message);
+        break;
+      }
+      continue;
+#endif
     } else if (id_df_status.repr != wuffs_base__suspension__short_read) {
       message = id_df_status.message();
       break;
@@ -579,6 +1258,11 @@ redirect:
       }
     }
   }
+#if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__WEBP)
+  // Join the loop filter thread (if any) before anything else touches the
+  // workbuf.
+  loop_filter_thread.reset();
+#endif
 
   // Decode any metadata after the frame.
   if (interested_in_metadata_after_the_frame) {
@@ -595,6 +1279,12 @@ redirect:
         if (!error_message.empty()) {
           return DecodeImageResult(std::move(error_message));
         }
+      } else if (id_dfc_status.repr == wuffs_base__note__i_o_seek) {
+        std::string error_message =
+            DecodeImageSeek(image_decoder, input, io_buf);
+        if (!error_message.empty()) {
+          return DecodeImageResult(std::move(error_message));
+        }
       } else if (id_dfc_status.repr != wuffs_base__suspension__short_read) {
         return DecodeImageResult(id_dfc_status.message());
       } else if (io_buf.meta.closed) {
@@ -96,6 +96,7 @@ class DecodeImageCallbacks {
   //  - WUFFS_BASE__FOURCC__TGA
   //  - WUFFS_BASE__FOURCC__TH
   //  - WUFFS_BASE__FOURCC__WBMP
+  //  - WUFFS_BASE__FOURCC__WEBM
   //  - WUFFS_BASE__FOURCC__WEBP
   //
   // The FOOBAR in WUFFS_BASE__FOURCC__FOBA is limited to four characters, but
@@ -256,6 +257,76 @@ struct DecodeImageArgFlags {
   // Extensible Metadata Platform.
   static constexpr uint64_t REPORT_METADATA_XMP = 0x0400;
 
+  // Parallel Strips.
+  //
+  // For PNG images with Apple's iDOT chunk, which splits the image's rows
+  // (and their zlib-compressed data) into separately compressed strips,
+  // DecodeImage decodes each strip on its own thread with its own decoder.
+  // The decoded pixels are the same either way, but the zlib checksum is not
+  // verified. This only applies when the sync_io::Input's I/O buffer already
+  // holds the whole file (e.g. for a sync_io::MemoryInput), the pixel format
+  // is not indexed and the pixel blend is WUFFS_BASE__PIXEL_BLEND__SRC. If a
+  // strip cannot be decoded separately, DecodeImage falls back to decoding
+  // the whole image on the calling thread. It is ignored if SelectDecoder
+  // returns something other than a wuffs_png__decoder for
+  // WUFFS_BASE__FOURCC__PNG, or if there is only one hardware thread.
+  static constexpr uint64_t PARALLEL_STRIPS = 0x0800;
+
+  // Parallel IDCT.
+  //
+  // For JPEG images, DecodeImage decodes the entropy-coded data on the
+  // calling thread and then applies the IDCT (Inverse Discrete Cosine
+  // Transform) to bands of MCU rows, up to one band per hardware thread, each
+  // on its own thread with its own delegate decoder. The decoded pixels are
+  // the same either way. This uses WUFFS_JPEG__QUIRK_DELEGATE_IDCT, which
+  // needs a larger work buffer. It is ignored if SelectDecoder returns
+  // something other than a wuffs_jpeg__decoder for WUFFS_BASE__FOURCC__JPEG,
+  // or if there is only one hardware thread.
+  static constexpr uint64_t PARALLEL_IDCT = 0x1000;
+
+  // Parallel Block Rows.
+  //
+  // For ETC2 images, DecodeImage splits the rows of 4×4 blocks into bands,
+  // up to one per hardware thread, and decodes each band on its own thread
+  // with its own decoder. The decoded pixels are the same either way. This
+  // only applies when the sync_io::Input's I/O buffer already holds the whole
+  // file (e.g. for a sync_io::MemoryInput) and the image is at least 128
+  // pixels high. It is ignored if SelectDecoder returns something other than
+  // a wuffs_etc2__decoder for WUFFS_BASE__FOURCC__ETC2.
+  static constexpr uint64_t PARALLEL_BLOCK_ROWS = 0x2000;
+
+  // Wavefront Macroblock Rows.
+  //
+  // For lossy WebP images with more than one DCT token partition, DecodeImage
+  // decodes each partition's rows of macroblocks on its own thread, each row
+  // staying two macroblocks behind the row above. The decoded pixels are the
+  // same either way. This uses WUFFS_VP8__QUIRK_DELEGATE_MACROBLOCK_ROWS and,
+  // like PIPELINE_LOOP_FILTER (below), is ignored if SelectDecoder returns
+  // something other than a wuffs_webp__decoder. For multi-partition images,
+  // it takes precedence over that flag.
+  static constexpr uint64_t WAVEFRONT_MACROBLOCK_ROWS = 0x4000;
+
+  // Pipeline Loop Filter.
+  //
+  // For lossy WebP images, DecodeImage runs the VP8 loop filter on a second
+  // thread, one row of macroblocks behind the calling thread, which decodes
+  // (reconstructs) the next row. The decoded pixels are the same either way.
+  // This uses WUFFS_VP8__QUIRK_DEFER_LOOP_FILTER. It is ignored if
+  // SelectDecoder returns something other than a wuffs_webp__decoder for
+  // WUFFS_BASE__FOURCC__WEBP.
+  static constexpr uint64_t PIPELINE_LOOP_FILTER = 0x8000;
+
+  // Skip Pixel Data.
+  //
+  // DecodeImage stops after decoding the image and frame configurations (and
+  // any opted-in metadata): no pixel or work buffers are allocated and the
+  // returned pixbuf has a valid pixcfg but no pixels. Metadata after the pixel
+  // data (e.g. a PNG's trailing eXIf or tEXt chunks) is still reported and,
+  // for decoders that support WUFFS_BASE__QUIRK_SEEK_PAST_PIXEL_DATA, the
+  // pixel data is skipped by calling sync_io::Input::Seek instead of reading
+  // it, so that scanning a file costs time proportional to its metadata size.
+  static constexpr uint64_t SKIP_PIXEL_DATA = 0x10000;
+
   uint64_t repr;
 };
 
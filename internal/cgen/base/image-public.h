@@ -999,17 +999,66 @@ wuffs_base__pixel_config__height(const wuffs_base__pixel_config* c) {
   return c ? c->private_impl.height : 0;
 }
 
+// wuffs_private_impl__pixel_config__plane_size sets *w and *h to the number of
+// samples per row and per column of a planar pixel config's p'th plane,
+// conscious of pixel subsampling. It returns false (and leaves *w and *h
+// unchanged) unless that plane has 8 bits per sample.
+static inline bool  //
+wuffs_private_impl__pixel_config__plane_size(const wuffs_base__pixel_config* c,
+                                             uint32_t p,
+                                             uint64_t* w,
+                                             uint64_t* h) {
+  uint32_t depth = wuffs_private_impl__pixel_format__bits_per_channel
+      [0x0F & (c->private_impl.pixfmt.repr >> (4 * (p & 3)))];
+  if (depth != 8) {
+    return false;
+  }
+  const wuffs_base__pixel_subsampling* s = &c->private_impl.pixsub;
+  uint64_t width = c->private_impl.width;
+  uint64_t height = c->private_impl.height;
+  *w = width ? ((((width - 1) +
+                  wuffs_base__pixel_subsampling__bias_x(s, p)) /
+                 wuffs_base__pixel_subsampling__denominator_x(s, p)) +
+                1)
+             : 0;
+  *h = height ? ((((height - 1) +
+                   wuffs_base__pixel_subsampling__bias_y(s, p)) /
+                  wuffs_base__pixel_subsampling__denominator_y(s, p)) +
+                 1)
+              : 0;
+  return true;
+}
+
 // TODO: this is the right API for planar (not interleaved) pixbufs? Should it
 // allow decoding into a color model different from the format's intrinsic one?
 // For example, decoding a JPEG image straight to RGBA instead of to YCbCr?
+//
+// For planar pixel formats, the planes are laid out one after another, each
+// with no padding between rows. Only 8 bits per sample is supported.
 static inline uint64_t  //
 wuffs_base__pixel_config__pixbuf_len(const wuffs_base__pixel_config* c) {
   if (!c) {
     return 0;
   }
   if (wuffs_base__pixel_format__is_planar(&c->private_impl.pixfmt)) {
-    // TODO: support planar pixel formats, concious of pixel subsampling.
-    return 0;
+    uint32_t num_planes =
+        wuffs_base__pixel_format__num_planes(&c->private_impl.pixfmt);
+    uint64_t n = 0;
+    uint32_t p;
+    for (p = 0; p < num_planes; p++) {
+      uint64_t w = 0;
+      uint64_t h = 0;
+      if (!wuffs_private_impl__pixel_config__plane_size(c, p, &w, &h)) {
+        return 0;
+      }
+      // w and h are each at most 0xFFFF_FFFF, so that (w * h) cannot
+      // overflow but (n + (w * h)) can.
+      if ((w * h) > (UINT64_MAX - n)) {
+        return 0;
+      }
+      n += w * h;
+    }
+    return n;
   }
   uint32_t bits_per_pixel =
       wuffs_base__pixel_format__bits_per_pixel(&c->private_impl.pixfmt);
@@ -1581,8 +1630,34 @@ wuffs_base__pixel_buffer__set_from_slice(wuffs_base__pixel_buffer* pb,
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
   if (wuffs_base__pixel_format__is_planar(&pixcfg->private_impl.pixfmt)) {
-    // TODO: support planar pixel formats, concious of pixel subsampling.
-    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+    // Split pixbuf_memory into consecutive planes, as per
+    // wuffs_base__pixel_config__pixbuf_len.
+    uint32_t num_planes =
+        wuffs_base__pixel_format__num_planes(&pixcfg->private_impl.pixfmt);
+    uint8_t* ptr = pixbuf_memory.ptr;
+    uint64_t len = pixbuf_memory.len;
+    uint32_t p;
+    for (p = 0; p < num_planes; p++) {
+      uint64_t w = 0;
+      uint64_t h = 0;
+      if (!wuffs_private_impl__pixel_config__plane_size(pixcfg, p, &w, &h)) {
+        memset(pb, 0, sizeof(*pb));
+        return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+      } else if ((w > ((uint64_t)SIZE_MAX)) || (h > (len / (w ? w : 1)))) {
+        memset(pb, 0, sizeof(*pb));
+        return wuffs_base__make_status(
+            wuffs_base__error__bad_argument_length_too_short);
+      }
+      wuffs_base__table_u8* tab = &pb->private_impl.planes[p];
+      tab->ptr = ptr;
+      tab->width = (size_t)w;
+      tab->height = (size_t)h;
+      tab->stride = (size_t)w;
+      ptr += w * h;
+      len -= w * h;
+    }
+    pb->pixcfg = *pixcfg;
+    return wuffs_base__make_status(NULL);
   }
   uint32_t bits_per_pixel =
       wuffs_base__pixel_format__bits_per_pixel(&pixcfg->private_impl.pixfmt);
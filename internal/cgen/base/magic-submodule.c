@@ -147,6 +147,7 @@ wuffs_base__magic_number_guess_fourcc(wuffs_base__slice_u8 prefix_data,
   } table[] = {
       {-0x30302020, "\x01\x00\x00"},                  // '00  'be
       {+0x41425852, "\x03\x03\x00\x08\x00"},          // ABXR
+      {+0x5745424D, "\x03\x1A\x45\xDF\xA3"},          // WEBM
       {+0x475A2020, "\x02\x1F\x8B\x08"},              // GZ
       {+0x5A535444, "\x03\x28\xB5\x2F\xFD"},          // ZSTD
       {+0x584D4C20, "\x05\x3C\x3F\x78\x6D\x6C\x20"},  // XML
@@ -433,9 +433,1310 @@ wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgbx_x86_avx2(
   }
 }
 
+// The bgr flavor (below) is like the bgrx flavor (above) except that it writes
+// 3 (not 4) bytes per pixel. The lines marked with a § differ and, again,
+// comments were stripped.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgr_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  if ((x + 32u) > x_end) {
+    wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgr(  // §
+        dst, x, x_end, y, up0, up1, up2);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (3u * ((size_t)x));  // §
+
+  const __m256i u0001 = _mm256_set1_epi16(+0x0001);
+  const __m256i u00FF = _mm256_set1_epi16(+0x00FF);
+  const __m256i uFF80 = _mm256_set1_epi16(-0x0080);
+  const __m256i uFFFF = _mm256_set1_epi16(-0x0001);
+
+  const __m256i p8000_p0000 = _mm256_set_epi16(  //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000);
+
+  const __m256i m3A5E = _mm256_set1_epi16(-0x3A5E);
+  const __m256i p66E9 = _mm256_set1_epi16(+0x66E9);
+  const __m256i m581A_p492E = _mm256_set_epi16(  //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A);
+
+  // § The shuffle_xxxx_to_xxx and permute_xxxx_to_xxx constants squeeze out
+  // every 4th byte (the X in BGRX), packing 8 pixels into the low 24 bytes.
+  const __m256i shuffle_xxxx_to_xxx = _mm256_set_epi8(  //
+      -0x80, -0x80, -0x80, -0x80, +0x0E, +0x0D, +0x0C, +0x0A,
+      +0x09, +0x08, +0x06, +0x05, +0x04, +0x02, +0x01, +0x00,  //
+      -0x80, -0x80, -0x80, -0x80, +0x0E, +0x0D, +0x0C, +0x0A,
+      +0x09, +0x08, +0x06, +0x05, +0x04, +0x02, +0x01, +0x00);
+  const __m256i permute_xxxx_to_xxx = _mm256_set_epi32(  //
+      +0x07, +0x03, +0x06, +0x05, +0x04, +0x02, +0x01, +0x00);
+
+  while (x < x_end) {
+    __m256i cb_all = _mm256_lddqu_si256((const __m256i*)(const void*)up1);
+    __m256i cr_all = _mm256_lddqu_si256((const __m256i*)(const void*)up2);
+    __m256i cb_eve = _mm256_add_epi16(uFF80, _mm256_and_si256(cb_all, u00FF));
+    __m256i cr_eve = _mm256_add_epi16(uFF80, _mm256_and_si256(cr_all, u00FF));
+    __m256i cb_odd = _mm256_add_epi16(uFF80, _mm256_srli_epi16(cb_all, 8));
+    __m256i cr_odd = _mm256_add_epi16(uFF80, _mm256_srli_epi16(cr_all, 8));
+
+    __m256i tmp_by_eve = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cb_eve, cb_eve), m3A5E), u0001),
+        1);
+    __m256i tmp_by_odd = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cb_odd, cb_odd), m3A5E), u0001),
+        1);
+    __m256i tmp_ry_eve = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cr_eve, cr_eve), p66E9), u0001),
+        1);
+    __m256i tmp_ry_odd = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cr_odd, cr_odd), p66E9), u0001),
+        1);
+
+    __m256i by_eve =
+        _mm256_add_epi16(tmp_by_eve, _mm256_add_epi16(cb_eve, cb_eve));
+    __m256i by_odd =
+        _mm256_add_epi16(tmp_by_odd, _mm256_add_epi16(cb_odd, cb_odd));
+    __m256i ry_eve = _mm256_add_epi16(tmp_ry_eve, cr_eve);
+    __m256i ry_odd = _mm256_add_epi16(tmp_ry_odd, cr_odd);
+
+    __m256i tmp0_gy_eve_lo = _mm256_madd_epi16(  //
+        _mm256_unpacklo_epi16(cb_eve, cr_eve), m581A_p492E);
+    __m256i tmp0_gy_eve_hi = _mm256_madd_epi16(  //
+        _mm256_unpackhi_epi16(cb_eve, cr_eve), m581A_p492E);
+    __m256i tmp0_gy_odd_lo = _mm256_madd_epi16(  //
+        _mm256_unpacklo_epi16(cb_odd, cr_odd), m581A_p492E);
+    __m256i tmp0_gy_odd_hi = _mm256_madd_epi16(  //
+        _mm256_unpackhi_epi16(cb_odd, cr_odd), m581A_p492E);
+
+    __m256i tmp1_gy_eve_lo =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_eve_lo, p8000_p0000), 16);
+    __m256i tmp1_gy_eve_hi =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_eve_hi, p8000_p0000), 16);
+    __m256i tmp1_gy_odd_lo =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_odd_lo, p8000_p0000), 16);
+    __m256i tmp1_gy_odd_hi =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_odd_hi, p8000_p0000), 16);
+
+    __m256i gy_eve = _mm256_sub_epi16(
+        _mm256_packs_epi32(tmp1_gy_eve_lo, tmp1_gy_eve_hi), cr_eve);
+    __m256i gy_odd = _mm256_sub_epi16(
+        _mm256_packs_epi32(tmp1_gy_odd_lo, tmp1_gy_odd_hi), cr_odd);
+
+    __m256i yy_all = _mm256_lddqu_si256((const __m256i*)(const void*)up0);
+    __m256i yy_eve = _mm256_and_si256(yy_all, u00FF);
+    __m256i yy_odd = _mm256_srli_epi16(yy_all, 8);
+
+    __m256i loose_b_eve = _mm256_add_epi16(by_eve, yy_eve);
+    __m256i loose_b_odd = _mm256_add_epi16(by_odd, yy_odd);
+    __m256i packed_b_eve = _mm256_packus_epi16(loose_b_eve, loose_b_eve);
+    __m256i packed_b_odd = _mm256_packus_epi16(loose_b_odd, loose_b_odd);
+
+    __m256i loose_g_eve = _mm256_add_epi16(gy_eve, yy_eve);
+    __m256i loose_g_odd = _mm256_add_epi16(gy_odd, yy_odd);
+    __m256i packed_g_eve = _mm256_packus_epi16(loose_g_eve, loose_g_eve);
+    __m256i packed_g_odd = _mm256_packus_epi16(loose_g_odd, loose_g_odd);
+
+    __m256i loose_r_eve = _mm256_add_epi16(ry_eve, yy_eve);
+    __m256i loose_r_odd = _mm256_add_epi16(ry_odd, yy_odd);
+    __m256i packed_r_eve = _mm256_packus_epi16(loose_r_eve, loose_r_eve);
+    __m256i packed_r_odd = _mm256_packus_epi16(loose_r_odd, loose_r_odd);
+
+    __m256i mix00 = _mm256_unpacklo_epi8(packed_b_eve, packed_g_eve);
+    __m256i mix01 = _mm256_unpacklo_epi8(packed_b_odd, packed_g_odd);
+    __m256i mix02 = _mm256_unpacklo_epi8(packed_r_eve, uFFFF);
+    __m256i mix03 = _mm256_unpacklo_epi8(packed_r_odd, uFFFF);
+
+    __m256i mix10 = _mm256_unpacklo_epi16(mix00, mix02);
+    __m256i mix11 = _mm256_unpacklo_epi16(mix01, mix03);
+    __m256i mix12 = _mm256_unpackhi_epi16(mix00, mix02);
+    __m256i mix13 = _mm256_unpackhi_epi16(mix01, mix03);
+
+    __m256i mix20 = _mm256_unpacklo_epi32(mix10, mix11);
+    __m256i mix21 = _mm256_unpackhi_epi32(mix10, mix11);
+    __m256i mix22 = _mm256_unpacklo_epi32(mix12, mix13);
+    __m256i mix23 = _mm256_unpackhi_epi32(mix12, mix13);
+
+    __m256i mix30 = _mm256_permute2x128_si256(mix20, mix21, 0x20);
+    __m256i mix31 = _mm256_permute2x128_si256(mix22, mix23, 0x20);
+    __m256i mix32 = _mm256_permute2x128_si256(mix20, mix21, 0x31);
+    __m256i mix33 = _mm256_permute2x128_si256(mix22, mix23, 0x31);
+
+    // § Squeeze and write out 96 bytes (32 BGR pixels), in 24 byte chunks.
+    __m256i mix40 = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(mix30, shuffle_xxxx_to_xxx), permute_xxxx_to_xxx);
+    __m256i mix41 = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(mix31, shuffle_xxxx_to_xxx), permute_xxxx_to_xxx);
+    __m256i mix42 = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(mix32, shuffle_xxxx_to_xxx), permute_xxxx_to_xxx);
+    __m256i mix43 = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(mix33, shuffle_xxxx_to_xxx), permute_xxxx_to_xxx);
+
+    _mm_storeu_si128((__m128i*)(void*)(dst_iter + 0x00),
+                     _mm256_castsi256_si128(mix40));
+    _mm_storel_epi64((__m128i*)(void*)(dst_iter + 0x10),
+                     _mm256_extracti128_si256(mix40, 1));
+    _mm_storeu_si128((__m128i*)(void*)(dst_iter + 0x18),
+                     _mm256_castsi256_si128(mix41));
+    _mm_storel_epi64((__m128i*)(void*)(dst_iter + 0x28),
+                     _mm256_extracti128_si256(mix41, 1));
+    _mm_storeu_si128((__m128i*)(void*)(dst_iter + 0x30),
+                     _mm256_castsi256_si128(mix42));
+    _mm_storel_epi64((__m128i*)(void*)(dst_iter + 0x40),
+                     _mm256_extracti128_si256(mix42, 1));
+    _mm_storeu_si128((__m128i*)(void*)(dst_iter + 0x48),
+                     _mm256_castsi256_si128(mix43));
+    _mm_storel_epi64((__m128i*)(void*)(dst_iter + 0x58),
+                     _mm256_extracti128_si256(mix43, 1));
+
+    uint32_t n = 32u - (31u & (x - x_end));
+    dst_iter += 3u * n;  // §
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    x += n;
+  }
+}
+
+// The rgb flavor (below) is exactly the same as the bgr flavor (above)
+// except for the lines marked with a § and that comments were stripped.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgb_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  if ((x + 32u) > x_end) {
+    wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgb(  // §
+        dst, x, x_end, y, up0, up1, up2);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (3u * ((size_t)x));  // §
+
+  const __m256i u0001 = _mm256_set1_epi16(+0x0001);
+  const __m256i u00FF = _mm256_set1_epi16(+0x00FF);
+  const __m256i uFF80 = _mm256_set1_epi16(-0x0080);
+  const __m256i uFFFF = _mm256_set1_epi16(-0x0001);
+
+  const __m256i p8000_p0000 = _mm256_set_epi16(  //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000);
+
+  const __m256i m3A5E = _mm256_set1_epi16(-0x3A5E);
+  const __m256i p66E9 = _mm256_set1_epi16(+0x66E9);
+  const __m256i m581A_p492E = _mm256_set_epi16(  //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A);
+
+  // § The shuffle_xxxx_to_xxx and permute_xxxx_to_xxx constants squeeze out
+  const __m256i shuffle_xxxx_to_xxx = _mm256_set_epi8(  //
+      -0x80, -0x80, -0x80, -0x80, +0x0E, +0x0D, +0x0C, +0x0A,
+      +0x09, +0x08, +0x06, +0x05, +0x04, +0x02, +0x01, +0x00,  //
+      -0x80, -0x80, -0x80, -0x80, +0x0E, +0x0D, +0x0C, +0x0A,
+      +0x09, +0x08, +0x06, +0x05, +0x04, +0x02, +0x01, +0x00);
+  const __m256i permute_xxxx_to_xxx = _mm256_set_epi32(  //
+      +0x07, +0x03, +0x06, +0x05, +0x04, +0x02, +0x01, +0x00);
+
+  while (x < x_end) {
+    __m256i cb_all = _mm256_lddqu_si256((const __m256i*)(const void*)up1);
+    __m256i cr_all = _mm256_lddqu_si256((const __m256i*)(const void*)up2);
+    __m256i cb_eve = _mm256_add_epi16(uFF80, _mm256_and_si256(cb_all, u00FF));
+    __m256i cr_eve = _mm256_add_epi16(uFF80, _mm256_and_si256(cr_all, u00FF));
+    __m256i cb_odd = _mm256_add_epi16(uFF80, _mm256_srli_epi16(cb_all, 8));
+    __m256i cr_odd = _mm256_add_epi16(uFF80, _mm256_srli_epi16(cr_all, 8));
+
+    __m256i tmp_by_eve = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cb_eve, cb_eve), m3A5E), u0001),
+        1);
+    __m256i tmp_by_odd = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cb_odd, cb_odd), m3A5E), u0001),
+        1);
+    __m256i tmp_ry_eve = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cr_eve, cr_eve), p66E9), u0001),
+        1);
+    __m256i tmp_ry_odd = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cr_odd, cr_odd), p66E9), u0001),
+        1);
+
+    __m256i by_eve =
+        _mm256_add_epi16(tmp_by_eve, _mm256_add_epi16(cb_eve, cb_eve));
+    __m256i by_odd =
+        _mm256_add_epi16(tmp_by_odd, _mm256_add_epi16(cb_odd, cb_odd));
+    __m256i ry_eve = _mm256_add_epi16(tmp_ry_eve, cr_eve);
+    __m256i ry_odd = _mm256_add_epi16(tmp_ry_odd, cr_odd);
+
+    __m256i tmp0_gy_eve_lo = _mm256_madd_epi16(  //
+        _mm256_unpacklo_epi16(cb_eve, cr_eve), m581A_p492E);
+    __m256i tmp0_gy_eve_hi = _mm256_madd_epi16(  //
+        _mm256_unpackhi_epi16(cb_eve, cr_eve), m581A_p492E);
+    __m256i tmp0_gy_odd_lo = _mm256_madd_epi16(  //
+        _mm256_unpacklo_epi16(cb_odd, cr_odd), m581A_p492E);
+    __m256i tmp0_gy_odd_hi = _mm256_madd_epi16(  //
+        _mm256_unpackhi_epi16(cb_odd, cr_odd), m581A_p492E);
+
+    __m256i tmp1_gy_eve_lo =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_eve_lo, p8000_p0000), 16);
+    __m256i tmp1_gy_eve_hi =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_eve_hi, p8000_p0000), 16);
+    __m256i tmp1_gy_odd_lo =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_odd_lo, p8000_p0000), 16);
+    __m256i tmp1_gy_odd_hi =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_odd_hi, p8000_p0000), 16);
+
+    __m256i gy_eve = _mm256_sub_epi16(
+        _mm256_packs_epi32(tmp1_gy_eve_lo, tmp1_gy_eve_hi), cr_eve);
+    __m256i gy_odd = _mm256_sub_epi16(
+        _mm256_packs_epi32(tmp1_gy_odd_lo, tmp1_gy_odd_hi), cr_odd);
+
+    __m256i yy_all = _mm256_lddqu_si256((const __m256i*)(const void*)up0);
+    __m256i yy_eve = _mm256_and_si256(yy_all, u00FF);
+    __m256i yy_odd = _mm256_srli_epi16(yy_all, 8);
+
+    __m256i loose_b_eve = _mm256_add_epi16(by_eve, yy_eve);
+    __m256i loose_b_odd = _mm256_add_epi16(by_odd, yy_odd);
+    __m256i packed_b_eve = _mm256_packus_epi16(loose_b_eve, loose_b_eve);
+    __m256i packed_b_odd = _mm256_packus_epi16(loose_b_odd, loose_b_odd);
+
+    __m256i loose_g_eve = _mm256_add_epi16(gy_eve, yy_eve);
+    __m256i loose_g_odd = _mm256_add_epi16(gy_odd, yy_odd);
+    __m256i packed_g_eve = _mm256_packus_epi16(loose_g_eve, loose_g_eve);
+    __m256i packed_g_odd = _mm256_packus_epi16(loose_g_odd, loose_g_odd);
+
+    __m256i loose_r_eve = _mm256_add_epi16(ry_eve, yy_eve);
+    __m256i loose_r_odd = _mm256_add_epi16(ry_odd, yy_odd);
+    __m256i packed_r_eve = _mm256_packus_epi16(loose_r_eve, loose_r_eve);
+    __m256i packed_r_odd = _mm256_packus_epi16(loose_r_odd, loose_r_odd);
+
+    // § Note the swapped B and R channels.
+    __m256i mix00 = _mm256_unpacklo_epi8(packed_r_eve, packed_g_eve);
+    __m256i mix01 = _mm256_unpacklo_epi8(packed_r_odd, packed_g_odd);
+    __m256i mix02 = _mm256_unpacklo_epi8(packed_b_eve, uFFFF);
+    __m256i mix03 = _mm256_unpacklo_epi8(packed_b_odd, uFFFF);
+
+    __m256i mix10 = _mm256_unpacklo_epi16(mix00, mix02);
+    __m256i mix11 = _mm256_unpacklo_epi16(mix01, mix03);
+    __m256i mix12 = _mm256_unpackhi_epi16(mix00, mix02);
+    __m256i mix13 = _mm256_unpackhi_epi16(mix01, mix03);
+
+    __m256i mix20 = _mm256_unpacklo_epi32(mix10, mix11);
+    __m256i mix21 = _mm256_unpackhi_epi32(mix10, mix11);
+    __m256i mix22 = _mm256_unpacklo_epi32(mix12, mix13);
+    __m256i mix23 = _mm256_unpackhi_epi32(mix12, mix13);
+
+    __m256i mix30 = _mm256_permute2x128_si256(mix20, mix21, 0x20);
+    __m256i mix31 = _mm256_permute2x128_si256(mix22, mix23, 0x20);
+    __m256i mix32 = _mm256_permute2x128_si256(mix20, mix21, 0x31);
+    __m256i mix33 = _mm256_permute2x128_si256(mix22, mix23, 0x31);
+
+    // § Squeeze and write out 96 bytes (32 RGB pixels), in 24 byte chunks.
+    __m256i mix40 = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(mix30, shuffle_xxxx_to_xxx), permute_xxxx_to_xxx);
+    __m256i mix41 = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(mix31, shuffle_xxxx_to_xxx), permute_xxxx_to_xxx);
+    __m256i mix42 = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(mix32, shuffle_xxxx_to_xxx), permute_xxxx_to_xxx);
+    __m256i mix43 = _mm256_permutevar8x32_epi32(
+        _mm256_shuffle_epi8(mix33, shuffle_xxxx_to_xxx), permute_xxxx_to_xxx);
+
+    _mm_storeu_si128((__m128i*)(void*)(dst_iter + 0x00),
+                     _mm256_castsi256_si128(mix40));
+    _mm_storel_epi64((__m128i*)(void*)(dst_iter + 0x10),
+                     _mm256_extracti128_si256(mix40, 1));
+    _mm_storeu_si128((__m128i*)(void*)(dst_iter + 0x18),
+                     _mm256_castsi256_si128(mix41));
+    _mm_storel_epi64((__m128i*)(void*)(dst_iter + 0x28),
+                     _mm256_extracti128_si256(mix41, 1));
+    _mm_storeu_si128((__m128i*)(void*)(dst_iter + 0x30),
+                     _mm256_castsi256_si128(mix42));
+    _mm_storel_epi64((__m128i*)(void*)(dst_iter + 0x40),
+                     _mm256_extracti128_si256(mix42, 1));
+    _mm_storeu_si128((__m128i*)(void*)(dst_iter + 0x48),
+                     _mm256_castsi256_si128(mix43));
+    _mm_storel_epi64((__m128i*)(void*)(dst_iter + 0x58),
+                     _mm256_extracti128_si256(mix43, 1));
+
+    uint32_t n = 32u - (31u & (x - x_end));
+    dst_iter += 3u * n;  // §
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    x += n;
+  }
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 32u) > x_end) {
+    wuffs_private_impl__swizzle_ycck__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const __m256i u0000 = _mm256_setzero_si256();
+  const __m256i u0001 = _mm256_set1_epi16(+0x0001);
+  const __m256i u007F = _mm256_set1_epi16(+0x007F);
+  const __m256i u00FF = _mm256_set1_epi16(+0x00FF);
+  const __m256i u8081 = _mm256_set1_epi16(-0x7F7F);
+  const __m256i uFF80 = _mm256_set1_epi16(-0x0080);
+  const __m256i uFFFF = _mm256_set1_epi16(-0x0001);
+
+  const __m256i p8000_p0000 = _mm256_set_epi16(  //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000);
+
+  const __m256i m3A5E = _mm256_set1_epi16(-0x3A5E);
+  const __m256i p66E9 = _mm256_set1_epi16(+0x66E9);
+  const __m256i m581A_p492E = _mm256_set_epi16(  //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A);
+
+  while (x < x_end) {
+    // Calculate the YCbCr to BGR conversion just like
+    // wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgrx_x86_avx2 does.
+    __m256i cb_all = _mm256_lddqu_si256((const __m256i*)(const void*)up1);
+    __m256i cr_all = _mm256_lddqu_si256((const __m256i*)(const void*)up2);
+    __m256i cb_eve = _mm256_add_epi16(uFF80, _mm256_and_si256(cb_all, u00FF));
+    __m256i cr_eve = _mm256_add_epi16(uFF80, _mm256_and_si256(cr_all, u00FF));
+    __m256i cb_odd = _mm256_add_epi16(uFF80, _mm256_srli_epi16(cb_all, 8));
+    __m256i cr_odd = _mm256_add_epi16(uFF80, _mm256_srli_epi16(cr_all, 8));
+
+    __m256i tmp_by_eve = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cb_eve, cb_eve), m3A5E), u0001),
+        1);
+    __m256i tmp_by_odd = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cb_odd, cb_odd), m3A5E), u0001),
+        1);
+    __m256i tmp_ry_eve = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cr_eve, cr_eve), p66E9), u0001),
+        1);
+    __m256i tmp_ry_odd = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cr_odd, cr_odd), p66E9), u0001),
+        1);
+
+    __m256i by_eve =
+        _mm256_add_epi16(tmp_by_eve, _mm256_add_epi16(cb_eve, cb_eve));
+    __m256i by_odd =
+        _mm256_add_epi16(tmp_by_odd, _mm256_add_epi16(cb_odd, cb_odd));
+    __m256i ry_eve = _mm256_add_epi16(tmp_ry_eve, cr_eve);
+    __m256i ry_odd = _mm256_add_epi16(tmp_ry_odd, cr_odd);
+
+    __m256i tmp0_gy_eve_lo = _mm256_madd_epi16(  //
+        _mm256_unpacklo_epi16(cb_eve, cr_eve), m581A_p492E);
+    __m256i tmp0_gy_eve_hi = _mm256_madd_epi16(  //
+        _mm256_unpackhi_epi16(cb_eve, cr_eve), m581A_p492E);
+    __m256i tmp0_gy_odd_lo = _mm256_madd_epi16(  //
+        _mm256_unpacklo_epi16(cb_odd, cr_odd), m581A_p492E);
+    __m256i tmp0_gy_odd_hi = _mm256_madd_epi16(  //
+        _mm256_unpackhi_epi16(cb_odd, cr_odd), m581A_p492E);
+
+    __m256i tmp1_gy_eve_lo =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_eve_lo, p8000_p0000), 16);
+    __m256i tmp1_gy_eve_hi =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_eve_hi, p8000_p0000), 16);
+    __m256i tmp1_gy_odd_lo =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_odd_lo, p8000_p0000), 16);
+    __m256i tmp1_gy_odd_hi =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_odd_hi, p8000_p0000), 16);
+
+    __m256i gy_eve = _mm256_sub_epi16(
+        _mm256_packs_epi32(tmp1_gy_eve_lo, tmp1_gy_eve_hi), cr_eve);
+    __m256i gy_odd = _mm256_sub_epi16(
+        _mm256_packs_epi32(tmp1_gy_odd_lo, tmp1_gy_odd_hi), cr_odd);
+
+    __m256i yy_all = _mm256_lddqu_si256((const __m256i*)(const void*)up0);
+    __m256i yy_eve = _mm256_and_si256(yy_all, u00FF);
+    __m256i yy_odd = _mm256_srli_epi16(yy_all, 8);
+
+    __m256i loose_b_eve = _mm256_add_epi16(by_eve, yy_eve);
+    __m256i loose_b_odd = _mm256_add_epi16(by_odd, yy_odd);
+    __m256i loose_g_eve = _mm256_add_epi16(gy_eve, yy_eve);
+    __m256i loose_g_odd = _mm256_add_epi16(gy_odd, yy_odd);
+    __m256i loose_r_eve = _mm256_add_epi16(ry_eve, yy_eve);
+    __m256i loose_r_odd = _mm256_add_epi16(ry_odd, yy_odd);
+
+    // ----
+
+    // Per wuffs_private_impl__swizzle_ycck__convert_4_general, clamp each
+    // B, G and R value to [0x00, 0xFF], invert it and then scale by the
+    // fourth (K, or W after inversion) component:
+    //
+    //  V = ((0xFF - clamp(V)) * W + 0x7F) / 0xFF
+    //
+    // The numerator fits in a u16. For every u16 value t, (t / 0xFF) equals
+    // ((t * 0x8081) >> 23), which is a mulhi (taking the high 16 bits of the
+    // 32-bit product) then a shift right by 7.
+    __m256i ww_all = _mm256_lddqu_si256((const __m256i*)(const void*)up3);
+    __m256i ww_eve = _mm256_and_si256(ww_all, u00FF);
+    __m256i ww_odd = _mm256_srli_epi16(ww_all, 8);
+
+    __m256i scaled_b_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_b_eve, u0000), u00FF)),
+                    ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_b_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_b_odd, u0000), u00FF)),
+                    ww_odd),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_g_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_g_eve, u0000), u00FF)),
+                    ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_g_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_g_odd, u0000), u00FF)),
+                    ww_odd),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_r_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_r_eve, u0000), u00FF)),
+                    ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_r_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_r_odd, u0000), u00FF)),
+                    ww_odd),
+                u007F),
+            u8081),
+        7);
+
+    __m256i packed_b_eve = _mm256_packus_epi16(scaled_b_eve, scaled_b_eve);
+    __m256i packed_b_odd = _mm256_packus_epi16(scaled_b_odd, scaled_b_odd);
+    __m256i packed_g_eve = _mm256_packus_epi16(scaled_g_eve, scaled_g_eve);
+    __m256i packed_g_odd = _mm256_packus_epi16(scaled_g_odd, scaled_g_odd);
+    __m256i packed_r_eve = _mm256_packus_epi16(scaled_r_eve, scaled_r_eve);
+    __m256i packed_r_odd = _mm256_packus_epi16(scaled_r_odd, scaled_r_odd);
+
+    // ----
+
+    // Mix and write out 32 BGRX pixels, again just like
+    // wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgrx_x86_avx2 does.
+    __m256i mix00 = _mm256_unpacklo_epi8(packed_b_eve, packed_g_eve);
+    __m256i mix01 = _mm256_unpacklo_epi8(packed_b_odd, packed_g_odd);
+    __m256i mix02 = _mm256_unpacklo_epi8(packed_r_eve, uFFFF);
+    __m256i mix03 = _mm256_unpacklo_epi8(packed_r_odd, uFFFF);
+
+    __m256i mix10 = _mm256_unpacklo_epi16(mix00, mix02);
+    __m256i mix11 = _mm256_unpacklo_epi16(mix01, mix03);
+    __m256i mix12 = _mm256_unpackhi_epi16(mix00, mix02);
+    __m256i mix13 = _mm256_unpackhi_epi16(mix01, mix03);
+
+    __m256i mix20 = _mm256_unpacklo_epi32(mix10, mix11);
+    __m256i mix21 = _mm256_unpackhi_epi32(mix10, mix11);
+    __m256i mix22 = _mm256_unpacklo_epi32(mix12, mix13);
+    __m256i mix23 = _mm256_unpackhi_epi32(mix12, mix13);
+
+    __m256i mix30 = _mm256_permute2x128_si256(mix20, mix21, 0x20);
+    __m256i mix31 = _mm256_permute2x128_si256(mix22, mix23, 0x20);
+    __m256i mix32 = _mm256_permute2x128_si256(mix20, mix21, 0x31);
+    __m256i mix33 = _mm256_permute2x128_si256(mix22, mix23, 0x31);
+
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x00), mix30);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x20), mix31);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x40), mix32);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x60), mix33);
+
+    uint32_t n = 32u - (31u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+// The ycck rgbx flavor (below) is exactly the same as the ycck bgrx flavor
+// (above) except for the lines marked with a § and that comments were
+// stripped.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 32u) > x_end) {
+    wuffs_private_impl__swizzle_ycck__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const __m256i u0000 = _mm256_setzero_si256();
+  const __m256i u0001 = _mm256_set1_epi16(+0x0001);
+  const __m256i u007F = _mm256_set1_epi16(+0x007F);
+  const __m256i u00FF = _mm256_set1_epi16(+0x00FF);
+  const __m256i u8081 = _mm256_set1_epi16(-0x7F7F);
+  const __m256i uFF80 = _mm256_set1_epi16(-0x0080);
+  const __m256i uFFFF = _mm256_set1_epi16(-0x0001);
+
+  const __m256i p8000_p0000 = _mm256_set_epi16(  //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000,        //
+      +0x0000, -0x8000, +0x0000, -0x8000);
+
+  const __m256i m3A5E = _mm256_set1_epi16(-0x3A5E);
+  const __m256i p66E9 = _mm256_set1_epi16(+0x66E9);
+  const __m256i m581A_p492E = _mm256_set_epi16(  //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A,        //
+      +0x492E, -0x581A, +0x492E, -0x581A);
+
+  while (x < x_end) {
+    __m256i cb_all = _mm256_lddqu_si256((const __m256i*)(const void*)up1);
+    __m256i cr_all = _mm256_lddqu_si256((const __m256i*)(const void*)up2);
+    __m256i cb_eve = _mm256_add_epi16(uFF80, _mm256_and_si256(cb_all, u00FF));
+    __m256i cr_eve = _mm256_add_epi16(uFF80, _mm256_and_si256(cr_all, u00FF));
+    __m256i cb_odd = _mm256_add_epi16(uFF80, _mm256_srli_epi16(cb_all, 8));
+    __m256i cr_odd = _mm256_add_epi16(uFF80, _mm256_srli_epi16(cr_all, 8));
+
+    __m256i tmp_by_eve = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cb_eve, cb_eve), m3A5E), u0001),
+        1);
+    __m256i tmp_by_odd = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cb_odd, cb_odd), m3A5E), u0001),
+        1);
+    __m256i tmp_ry_eve = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cr_eve, cr_eve), p66E9), u0001),
+        1);
+    __m256i tmp_ry_odd = _mm256_srai_epi16(
+        _mm256_add_epi16(
+            _mm256_mulhi_epi16(_mm256_add_epi16(cr_odd, cr_odd), p66E9), u0001),
+        1);
+
+    __m256i by_eve =
+        _mm256_add_epi16(tmp_by_eve, _mm256_add_epi16(cb_eve, cb_eve));
+    __m256i by_odd =
+        _mm256_add_epi16(tmp_by_odd, _mm256_add_epi16(cb_odd, cb_odd));
+    __m256i ry_eve = _mm256_add_epi16(tmp_ry_eve, cr_eve);
+    __m256i ry_odd = _mm256_add_epi16(tmp_ry_odd, cr_odd);
+
+    __m256i tmp0_gy_eve_lo = _mm256_madd_epi16(  //
+        _mm256_unpacklo_epi16(cb_eve, cr_eve), m581A_p492E);
+    __m256i tmp0_gy_eve_hi = _mm256_madd_epi16(  //
+        _mm256_unpackhi_epi16(cb_eve, cr_eve), m581A_p492E);
+    __m256i tmp0_gy_odd_lo = _mm256_madd_epi16(  //
+        _mm256_unpacklo_epi16(cb_odd, cr_odd), m581A_p492E);
+    __m256i tmp0_gy_odd_hi = _mm256_madd_epi16(  //
+        _mm256_unpackhi_epi16(cb_odd, cr_odd), m581A_p492E);
+
+    __m256i tmp1_gy_eve_lo =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_eve_lo, p8000_p0000), 16);
+    __m256i tmp1_gy_eve_hi =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_eve_hi, p8000_p0000), 16);
+    __m256i tmp1_gy_odd_lo =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_odd_lo, p8000_p0000), 16);
+    __m256i tmp1_gy_odd_hi =
+        _mm256_srai_epi32(_mm256_add_epi32(tmp0_gy_odd_hi, p8000_p0000), 16);
+
+    __m256i gy_eve = _mm256_sub_epi16(
+        _mm256_packs_epi32(tmp1_gy_eve_lo, tmp1_gy_eve_hi), cr_eve);
+    __m256i gy_odd = _mm256_sub_epi16(
+        _mm256_packs_epi32(tmp1_gy_odd_lo, tmp1_gy_odd_hi), cr_odd);
+
+    __m256i yy_all = _mm256_lddqu_si256((const __m256i*)(const void*)up0);
+    __m256i yy_eve = _mm256_and_si256(yy_all, u00FF);
+    __m256i yy_odd = _mm256_srli_epi16(yy_all, 8);
+
+    __m256i loose_b_eve = _mm256_add_epi16(by_eve, yy_eve);
+    __m256i loose_b_odd = _mm256_add_epi16(by_odd, yy_odd);
+    __m256i loose_g_eve = _mm256_add_epi16(gy_eve, yy_eve);
+    __m256i loose_g_odd = _mm256_add_epi16(gy_odd, yy_odd);
+    __m256i loose_r_eve = _mm256_add_epi16(ry_eve, yy_eve);
+    __m256i loose_r_odd = _mm256_add_epi16(ry_odd, yy_odd);
+
+    __m256i ww_all = _mm256_lddqu_si256((const __m256i*)(const void*)up3);
+    __m256i ww_eve = _mm256_and_si256(ww_all, u00FF);
+    __m256i ww_odd = _mm256_srli_epi16(ww_all, 8);
+
+    __m256i scaled_b_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_b_eve, u0000), u00FF)),
+                    ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_b_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_b_odd, u0000), u00FF)),
+                    ww_odd),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_g_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_g_eve, u0000), u00FF)),
+                    ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_g_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_g_odd, u0000), u00FF)),
+                    ww_odd),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_r_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_r_eve, u0000), u00FF)),
+                    ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_r_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(
+                    _mm256_sub_epi16(
+                        u00FF, _mm256_min_epi16(
+                                   _mm256_max_epi16(loose_r_odd, u0000), u00FF)),
+                    ww_odd),
+                u007F),
+            u8081),
+        7);
+
+    __m256i packed_b_eve = _mm256_packus_epi16(scaled_b_eve, scaled_b_eve);
+    __m256i packed_b_odd = _mm256_packus_epi16(scaled_b_odd, scaled_b_odd);
+    __m256i packed_g_eve = _mm256_packus_epi16(scaled_g_eve, scaled_g_eve);
+    __m256i packed_g_odd = _mm256_packus_epi16(scaled_g_odd, scaled_g_odd);
+    __m256i packed_r_eve = _mm256_packus_epi16(scaled_r_eve, scaled_r_eve);
+    __m256i packed_r_odd = _mm256_packus_epi16(scaled_r_odd, scaled_r_odd);
+
+    // § Note the swapped B and R channels.
+    __m256i mix00 = _mm256_unpacklo_epi8(packed_r_eve, packed_g_eve);
+    __m256i mix01 = _mm256_unpacklo_epi8(packed_r_odd, packed_g_odd);
+    __m256i mix02 = _mm256_unpacklo_epi8(packed_b_eve, uFFFF);
+    __m256i mix03 = _mm256_unpacklo_epi8(packed_b_odd, uFFFF);
+
+    __m256i mix10 = _mm256_unpacklo_epi16(mix00, mix02);
+    __m256i mix11 = _mm256_unpacklo_epi16(mix01, mix03);
+    __m256i mix12 = _mm256_unpackhi_epi16(mix00, mix02);
+    __m256i mix13 = _mm256_unpackhi_epi16(mix01, mix03);
+
+    __m256i mix20 = _mm256_unpacklo_epi32(mix10, mix11);
+    __m256i mix21 = _mm256_unpackhi_epi32(mix10, mix11);
+    __m256i mix22 = _mm256_unpacklo_epi32(mix12, mix13);
+    __m256i mix23 = _mm256_unpackhi_epi32(mix12, mix13);
+
+    __m256i mix30 = _mm256_permute2x128_si256(mix20, mix21, 0x20);
+    __m256i mix31 = _mm256_permute2x128_si256(mix22, mix23, 0x20);
+    __m256i mix32 = _mm256_permute2x128_si256(mix20, mix21, 0x31);
+    __m256i mix33 = _mm256_permute2x128_si256(mix22, mix23, 0x31);
+
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x00), mix30);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x20), mix31);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x40), mix32);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x60), mix33);
+
+    uint32_t n = 32u - (31u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+// The cmyk flavor (below) is like the ycck flavor (above) except that there's
+// no YCbCr to RGB conversion and no inversion, per
+// wuffs_private_impl__swizzle_cmyk__convert_4_general.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 32u) > x_end) {
+    wuffs_private_impl__swizzle_cmyk__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const __m256i u007F = _mm256_set1_epi16(+0x007F);
+  const __m256i u00FF = _mm256_set1_epi16(+0x00FF);
+  const __m256i u8081 = _mm256_set1_epi16(-0x7F7F);
+  const __m256i uFFFF = _mm256_set1_epi16(-0x0001);
+
+  while (x < x_end) {
+    __m256i rr_all = _mm256_lddqu_si256((const __m256i*)(const void*)up0);
+    __m256i gg_all = _mm256_lddqu_si256((const __m256i*)(const void*)up1);
+    __m256i bb_all = _mm256_lddqu_si256((const __m256i*)(const void*)up2);
+    __m256i ww_all = _mm256_lddqu_si256((const __m256i*)(const void*)up3);
+    __m256i ww_eve = _mm256_and_si256(ww_all, u00FF);
+    __m256i ww_odd = _mm256_srli_epi16(ww_all, 8);
+
+    __m256i scaled_b_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_and_si256(bb_all, u00FF), ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_b_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_srli_epi16(bb_all, 8), ww_odd),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_g_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_and_si256(gg_all, u00FF), ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_g_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_srli_epi16(gg_all, 8), ww_odd),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_r_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_and_si256(rr_all, u00FF), ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_r_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_srli_epi16(rr_all, 8), ww_odd),
+                u007F),
+            u8081),
+        7);
+
+    __m256i packed_b_eve = _mm256_packus_epi16(scaled_b_eve, scaled_b_eve);
+    __m256i packed_b_odd = _mm256_packus_epi16(scaled_b_odd, scaled_b_odd);
+    __m256i packed_g_eve = _mm256_packus_epi16(scaled_g_eve, scaled_g_eve);
+    __m256i packed_g_odd = _mm256_packus_epi16(scaled_g_odd, scaled_g_odd);
+    __m256i packed_r_eve = _mm256_packus_epi16(scaled_r_eve, scaled_r_eve);
+    __m256i packed_r_odd = _mm256_packus_epi16(scaled_r_odd, scaled_r_odd);
+
+    __m256i mix00 = _mm256_unpacklo_epi8(packed_b_eve, packed_g_eve);
+    __m256i mix01 = _mm256_unpacklo_epi8(packed_b_odd, packed_g_odd);
+    __m256i mix02 = _mm256_unpacklo_epi8(packed_r_eve, uFFFF);
+    __m256i mix03 = _mm256_unpacklo_epi8(packed_r_odd, uFFFF);
+
+    __m256i mix10 = _mm256_unpacklo_epi16(mix00, mix02);
+    __m256i mix11 = _mm256_unpacklo_epi16(mix01, mix03);
+    __m256i mix12 = _mm256_unpackhi_epi16(mix00, mix02);
+    __m256i mix13 = _mm256_unpackhi_epi16(mix01, mix03);
+
+    __m256i mix20 = _mm256_unpacklo_epi32(mix10, mix11);
+    __m256i mix21 = _mm256_unpackhi_epi32(mix10, mix11);
+    __m256i mix22 = _mm256_unpacklo_epi32(mix12, mix13);
+    __m256i mix23 = _mm256_unpackhi_epi32(mix12, mix13);
+
+    __m256i mix30 = _mm256_permute2x128_si256(mix20, mix21, 0x20);
+    __m256i mix31 = _mm256_permute2x128_si256(mix22, mix23, 0x20);
+    __m256i mix32 = _mm256_permute2x128_si256(mix20, mix21, 0x31);
+    __m256i mix33 = _mm256_permute2x128_si256(mix22, mix23, 0x31);
+
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x00), mix30);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x20), mix31);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x40), mix32);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x60), mix33);
+
+    uint32_t n = 32u - (31u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+// The cmyk rgbx flavor (below) is exactly the same as the cmyk bgrx flavor
+// (above) except for the lines marked with a § and that comments were
+// stripped.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  if ((x + 32u) > x_end) {
+    wuffs_private_impl__swizzle_cmyk__convert_4_general(  //
+        dst, x, x_end, y, up0, up1, up2, up3);
+    return;
+  }
+
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  const __m256i u007F = _mm256_set1_epi16(+0x007F);
+  const __m256i u00FF = _mm256_set1_epi16(+0x00FF);
+  const __m256i u8081 = _mm256_set1_epi16(-0x7F7F);
+  const __m256i uFFFF = _mm256_set1_epi16(-0x0001);
+
+  while (x < x_end) {
+    __m256i rr_all = _mm256_lddqu_si256((const __m256i*)(const void*)up0);
+    __m256i gg_all = _mm256_lddqu_si256((const __m256i*)(const void*)up1);
+    __m256i bb_all = _mm256_lddqu_si256((const __m256i*)(const void*)up2);
+    __m256i ww_all = _mm256_lddqu_si256((const __m256i*)(const void*)up3);
+    __m256i ww_eve = _mm256_and_si256(ww_all, u00FF);
+    __m256i ww_odd = _mm256_srli_epi16(ww_all, 8);
+
+    __m256i scaled_b_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_and_si256(bb_all, u00FF), ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_b_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_srli_epi16(bb_all, 8), ww_odd),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_g_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_and_si256(gg_all, u00FF), ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_g_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_srli_epi16(gg_all, 8), ww_odd),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_r_eve = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_and_si256(rr_all, u00FF), ww_eve),
+                u007F),
+            u8081),
+        7);
+    __m256i scaled_r_odd = _mm256_srli_epi16(
+        _mm256_mulhi_epu16(
+            _mm256_add_epi16(
+                _mm256_mullo_epi16(_mm256_srli_epi16(rr_all, 8), ww_odd),
+                u007F),
+            u8081),
+        7);
+
+    __m256i packed_b_eve = _mm256_packus_epi16(scaled_b_eve, scaled_b_eve);
+    __m256i packed_b_odd = _mm256_packus_epi16(scaled_b_odd, scaled_b_odd);
+    __m256i packed_g_eve = _mm256_packus_epi16(scaled_g_eve, scaled_g_eve);
+    __m256i packed_g_odd = _mm256_packus_epi16(scaled_g_odd, scaled_g_odd);
+    __m256i packed_r_eve = _mm256_packus_epi16(scaled_r_eve, scaled_r_eve);
+    __m256i packed_r_odd = _mm256_packus_epi16(scaled_r_odd, scaled_r_odd);
+
+    // § Note the swapped B and R channels.
+    __m256i mix00 = _mm256_unpacklo_epi8(packed_r_eve, packed_g_eve);
+    __m256i mix01 = _mm256_unpacklo_epi8(packed_r_odd, packed_g_odd);
+    __m256i mix02 = _mm256_unpacklo_epi8(packed_b_eve, uFFFF);
+    __m256i mix03 = _mm256_unpacklo_epi8(packed_b_odd, uFFFF);
+
+    __m256i mix10 = _mm256_unpacklo_epi16(mix00, mix02);
+    __m256i mix11 = _mm256_unpacklo_epi16(mix01, mix03);
+    __m256i mix12 = _mm256_unpackhi_epi16(mix00, mix02);
+    __m256i mix13 = _mm256_unpackhi_epi16(mix01, mix03);
+
+    __m256i mix20 = _mm256_unpacklo_epi32(mix10, mix11);
+    __m256i mix21 = _mm256_unpackhi_epi32(mix10, mix11);
+    __m256i mix22 = _mm256_unpacklo_epi32(mix12, mix13);
+    __m256i mix23 = _mm256_unpackhi_epi32(mix12, mix13);
+
+    __m256i mix30 = _mm256_permute2x128_si256(mix20, mix21, 0x20);
+    __m256i mix31 = _mm256_permute2x128_si256(mix22, mix23, 0x20);
+    __m256i mix32 = _mm256_permute2x128_si256(mix20, mix21, 0x31);
+    __m256i mix33 = _mm256_permute2x128_si256(mix22, mix23, 0x31);
+
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x00), mix30);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x20), mix31);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x40), mix32);
+    _mm256_storeu_si256((__m256i*)(void*)(dst_iter + 0x60), mix33);
+
+    uint32_t n = 32u - (31u & (x - x_end));
+    dst_iter += 4u * n;
+    up0 += n;
+    up1 += n;
+    up2 += n;
+    up3 += n;
+    x += n;
+  }
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor_ignored,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column_ignored,
+    bool last_column_ignored) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp = src_ptr_major;
+
+  if (src_len < 32) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    while (src_len--) {
+      uint8_t sv = *sp++;
+      *dp++ = sv;
+      *dp++ = sv;
+    }
+    return dst_ptr;
+  }
+
+  while (src_len > 0u) {
+    // Load 32 samples and duplicate each one. As unpacking works within
+    // 128-bit lanes, permute to restore the order.
+    //
+    // step1_lo = [s00 s00 s01 s01 .. s07 s07  s16 s16 s17 s17 .. s23 s23]
+    // step1_hi = [s08 s08 s09 s09 .. s15 s15  s24 s24 s25 s25 .. s31 s31]
+    __m256i sv = _mm256_lddqu_si256((const __m256i*)(const void*)sp);
+    __m256i step1_lo = _mm256_unpacklo_epi8(sv, sv);
+    __m256i step1_hi = _mm256_unpackhi_epi8(sv, sv);
+    _mm256_storeu_si256((__m256i*)(void*)(dp + 0x00),
+                        _mm256_permute2x128_si256(step1_lo, step1_hi, 0x20));
+    _mm256_storeu_si256((__m256i*)(void*)(dp + 0x20),
+                        _mm256_permute2x128_si256(step1_lo, step1_hi, 0x31));
+
+    size_t n = 32u - (31u & (0u - src_len));
+    dp += 2u * n;
+    sp += n;
+    src_len -= n;
+  }
+
+  return dst_ptr;
+}
+
 #if defined(__GNUC__) && !defined(__clang__)
 // No-op.
 #else
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column_ignored,
+    bool last_column_ignored) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp_major = src_ptr_major;
+  const uint8_t* sp_minor = src_ptr_minor;
+
+  if (src_len < 32) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    while (src_len--) {
+      *dp++ = (uint8_t)(((3u * ((uint32_t)(*sp_major++))) +  //
+                         (1u * ((uint32_t)(*sp_minor++))) +  //
+                         h1v2_bias) >>
+                        2u);
+    }
+    return dst_ptr;
+  }
+
+  const __m256i k0103 = _mm256_set1_epi16(0x0103);
+  const __m256i bias = _mm256_set1_epi16((int16_t)h1v2_bias);
+
+  while (src_len > 0u) {
+    // Load 32 samples from the major (jxx) and minor (nxx) rows and unpack.
+    //
+    // step1_lo = [j00 n00 j01 n01 .. j07 n07  j16 n16 j17 n17 .. j23 n23]
+    // step1_hi = [j08 n08 j09 n09 .. j15 n15  j24 n24 j25 n25 .. j31 n31]
+    __m256i major = _mm256_lddqu_si256((const __m256i*)(const void*)sp_major);
+    __m256i minor = _mm256_lddqu_si256((const __m256i*)(const void*)sp_minor);
+    __m256i step1_lo = _mm256_unpacklo_epi8(major, minor);
+    __m256i step1_hi = _mm256_unpackhi_epi8(major, minor);
+
+    // Multiply-add, bias and divide by 4 (which is 3+1) to get u16x16 vectors
+    // whose elements are all in the range [0x00, 0xFF].
+    //
+    // step2_lo = [(3*j00 + 1*n00 + bias) >> 2 .. (3*j23 + 1*n23 + bias) >> 2]
+    // step2_hi = [(3*j08 + 1*n08 + bias) >> 2 .. (3*j31 + 1*n31 + bias) >> 2]
+    __m256i step2_lo = _mm256_srli_epi16(
+        _mm256_add_epi16(_mm256_maddubs_epi16(step1_lo, k0103), bias), 2);
+    __m256i step2_hi = _mm256_srli_epi16(
+        _mm256_add_epi16(_mm256_maddubs_epi16(step1_hi, k0103), bias), 2);
+
+    // Pack and store. Both unpack and pack work within 128-bit lanes, so no
+    // permute is needed.
+    _mm256_storeu_si256((__m256i*)(void*)dp,
+                        _mm256_packus_epi16(step2_lo, step2_hi));
+
+    // Advance by up to 32 samples. The first iteration might be smaller than
+    // 32 so that all of the remaining steps are exactly 32.
+    size_t n = 32u - (31u & (0u - src_len));
+    dp += n;
+    sp_major += n;
+    sp_minor += n;
+    src_len -= n;
+  }
+
+  return dst_ptr;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp = src_ptr_major;
+
+  if (first_column) {
+    src_len--;
+    if ((src_len <= 0u) && last_column) {
+      uint8_t sv = *sp++;
+      *dp++ = sv;
+      *dp++ = sv;
+      return dst_ptr;
+    }
+    uint32_t svp1 = sp[+1];
+    uint8_t sv = *sp++;
+    *dp++ = sv;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svp1 + 2u) >> 2u);
+    if (src_len <= 0u) {
+      return dst_ptr;
+    }
+  }
+
+  if (last_column) {
+    src_len--;
+  }
+
+  if (src_len < 32) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    for (; src_len > 0u; src_len--) {
+      uint32_t svm1 = sp[-1];
+      uint32_t svp1 = sp[+1];
+      uint32_t sv3 = 3u * (uint32_t)(*sp++);
+      *dp++ = (uint8_t)((sv3 + svm1 + 1u) >> 2u);
+      *dp++ = (uint8_t)((sv3 + svp1 + 2u) >> 2u);
+    }
+
+  } else {
+    const __m256i k0103 = _mm256_set1_epi16(0x0103);
+    const __m256i u0001 = _mm256_set1_epi16(0x0001);
+    const __m256i u0002 = _mm256_set1_epi16(0x0002);
+
+    while (src_len > 0u) {
+      // Load 1+32+1 samples (three u8x32 vectors).
+      //
+      // p0 = [s00 s01 s02 s03 .. s28 s29 s30 s31]   // p0 = "plus  0"
+      // m1 = [sm1 s00 s01 s02 .. s27 s28 s29 s30]   // m1 = "minus 1"
+      // p1 = [s01 s02 s03 s04 .. s29 s30 s31 s32]   // p1 = "plus  1"
+      __m256i p0 = _mm256_lddqu_si256((const __m256i*)(const void*)(sp + 0));
+      __m256i m1 = _mm256_lddqu_si256((const __m256i*)(const void*)(sp - 1));
+      __m256i p1 = _mm256_lddqu_si256((const __m256i*)(const void*)(sp + 1));
+
+      // Unpack and multiply-add to get u16x16 vectors.
+      //
+      // step1_m1_lo = [3*s00+1*sm1 3*s01+1*s00 .. 3*s23+1*s22]
+      // step1_m1_hi = [3*s08+1*s07 3*s09+1*s08 .. 3*s31+1*s30]
+      // step1_p1_lo = [3*s00+1*s01 3*s01+1*s02 .. 3*s23+1*s24]
+      // step1_p1_hi = [3*s08+1*s09 3*s09+1*s10 .. 3*s31+1*s32]
+      __m256i step1_m1_lo =
+          _mm256_maddubs_epi16(_mm256_unpacklo_epi8(p0, m1), k0103);
+      __m256i step1_m1_hi =
+          _mm256_maddubs_epi16(_mm256_unpackhi_epi8(p0, m1), k0103);
+      __m256i step1_p1_lo =
+          _mm256_maddubs_epi16(_mm256_unpacklo_epi8(p0, p1), k0103);
+      __m256i step1_p1_hi =
+          _mm256_maddubs_epi16(_mm256_unpackhi_epi8(p0, p1), k0103);
+
+      // Bias by 1 (on the left) or 2 (on the right) and then divide by 4
+      // (which is 3+1) to get a weighted average. Like
+      // wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_x86_avx2,
+      // shift the p1 (right) values left by 8 so that a bitwise-or produces
+      // interleaved u8x32 vectors.
+      __m256i step2_lo = _mm256_or_si256(
+          _mm256_srli_epi16(_mm256_add_epi16(step1_m1_lo, u0001), 2),
+          _mm256_slli_epi16(
+              _mm256_srli_epi16(_mm256_add_epi16(step1_p1_lo, u0002), 2), 8));
+      __m256i step2_hi = _mm256_or_si256(
+          _mm256_srli_epi16(_mm256_add_epi16(step1_m1_hi, u0001), 2),
+          _mm256_slli_epi16(
+              _mm256_srli_epi16(_mm256_add_epi16(step1_p1_hi, u0002), 2), 8));
+
+      // Permute and store.
+      //
+      // step3_00_31 = [d00 d01 .. d14 d15  d16 d17 .. d30 d31]
+      // step3_32_63 = [d32 d33 .. d46 d47  d48 d49 .. d62 d63]
+      __m256i step3_00_31 = _mm256_permute2x128_si256(step2_lo, step2_hi, 0x20);
+      __m256i step3_32_63 = _mm256_permute2x128_si256(step2_lo, step2_hi, 0x31);
+      _mm256_storeu_si256((__m256i*)(void*)(dp + 0x00), step3_00_31);
+      _mm256_storeu_si256((__m256i*)(void*)(dp + 0x20), step3_32_63);
+
+      // Advance by up to 32 source samples (64 destination samples). The first
+      // iteration might be smaller than 32 so that all of the remaining steps
+      // are exactly 32.
+      size_t n = 32u - (31u & (0u - src_len));
+      dp += 2u * n;
+      sp += n;
+      src_len -= n;
+    }
+  }
+
+  if (last_column) {
+    uint32_t svm1 = sp[-1];
+    uint8_t sv = *sp++;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svm1 + 1u) >> 2u);
+    *dp++ = sv;
+  }
+
+  return dst_ptr;
+}
+
 WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
 static const uint8_t*  //
 wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_x86_avx2(
@@ -33,9 +33,112 @@ wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgbx_x86_avx2(
     const uint8_t* up1,
     const uint8_t* up2);
 
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgr_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgb_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_ycck__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor_ignored,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column_ignored,
+    bool last_column_ignored);
+
 #if defined(__GNUC__) && !defined(__clang__)
 // No-op.
 #else
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column_ignored,
+    bool last_column_ignored);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column);
+
 WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
 static const uint8_t*  //
 wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_x86_avx2(
@@ -258,6 +361,50 @@ wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgbx(
   }
 }
 
+static void  //
+wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgr(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (3u * ((size_t)x));
+
+  for (; x < x_end; x++) {
+    uint32_t color =                                   //
+        wuffs_base__color_ycc_bt601fr__as__color_u32(  //
+            *up0++, *up1++, *up2++);
+    wuffs_base__poke_u24le__no_bounds_check(dst_iter, color);
+    dst_iter += 3u;
+  }
+}
+
+static void  //
+wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgb(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (3u * ((size_t)x));
+
+  for (; x < x_end; x++) {
+    uint32_t color =                                        //
+        wuffs_base__color_ycc_bt601fr__as__color_u32_abgr(  //
+            *up0++, *up1++, *up2++);
+    wuffs_base__poke_u24le__no_bounds_check(dst_iter, color);
+    dst_iter += 3u;
+  }
+}
+
 static void  //
 wuffs_private_impl__swizzle_ycc_bt601sr__convert_3_general(
     wuffs_base__pixel_buffer* dst,
@@ -1313,6 +1460,37 @@ wuffs_private_impl__swizzle_flattened_length(uint32_t width,
   return ((scaled_height - 1u) * stride) + scaled_width;
 }
 
+// wuffs_private_impl__swizzle_ycc__copy_plane copies the samples covering the
+// pixels [x_min_incl .. x_max_excl) × [y_min_incl .. y_max_excl) from the src
+// plane to the dst plane, which both have inv_h and inv_v pixels per sample
+// (horizontally and vertically).
+static wuffs_base__status  //
+wuffs_private_impl__swizzle_ycc__copy_plane(wuffs_base__table_u8 dst,
+                                            uint32_t x_min_incl,
+                                            uint32_t x_max_excl,
+                                            uint32_t y_min_incl,
+                                            uint32_t y_max_excl,
+                                            wuffs_base__slice_u8 src,
+                                            uint32_t stride,
+                                            uint32_t inv_h,
+                                            uint32_t inv_v) {
+  uint64_t i0 = x_min_incl / inv_h;
+  uint64_t i1 = ((((uint64_t)x_max_excl) - 1u) / inv_h) + 1u;
+  uint64_t j0 = y_min_incl / inv_v;
+  uint64_t j1 = ((((uint64_t)y_max_excl) - 1u) / inv_v) + 1u;
+  if ((i1 > dst.width) || (j1 > dst.height) ||
+      (src.len < (((j1 - 1u) * stride) + i1))) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+
+  size_t n = (size_t)(i1 - i0);
+  uint64_t j;
+  for (j = j0; j < j1; j++) {
+    memcpy(dst.ptr + (j * dst.stride) + i0, src.ptr + (j * stride) + i0, n);
+  }
+  return wuffs_base__make_status(NULL);
+}
+
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
 wuffs_base__pixel_swizzler__swizzle_ycck(
     const wuffs_base__pixel_swizzler* p,
@@ -1477,9 +1655,46 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
   }
 
   if (wuffs_base__pixel_format__is_planar(&dst->pixcfg.private_impl.pixfmt)) {
-    // TODO: see wuffs_base__pixel_buffer__set_color_u32_at's TODO.
+    // A planar YCbCr destination receives the source samples as is, skipping
+    // the upsampling and color conversion. The destination's subsampling has
+    // to match the source's (and the ycc_model is implied, not applied).
+#if defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ENABLE_ALLOWLIST) && \
+    !defined(WUFFS_CONFIG__DST_PIXEL_FORMAT__ALLOW_YCBCR)
     return wuffs_base__make_status(
-        wuffs_base__error__unsupported_pixel_swizzler_option);
+        wuffs_base__error__disabled_by_wuffs_config_dst_pixel_format_enable_allowlist);
+#else
+    const wuffs_base__pixel_subsampling* pixsub =
+        &dst->pixcfg.private_impl.pixsub;
+    if ((dst->pixcfg.private_impl.pixfmt.repr !=
+         WUFFS_BASE__PIXEL_FORMAT__YCBCR) ||
+        (ycc_model >= WUFFS_BASE__YCC_MODEL__RGB) ||  //
+        (h3 != 0u) || (v3 != 0u) ||                   //
+        ((pixsub->repr & 0xCCCCCC) != 0u) ||          // Non-zero biases.
+        (wuffs_base__pixel_subsampling__denominator_x(pixsub, 0) != inv_h0) ||
+        (wuffs_base__pixel_subsampling__denominator_x(pixsub, 1) != inv_h1) ||
+        (wuffs_base__pixel_subsampling__denominator_x(pixsub, 2) != inv_h2) ||
+        (wuffs_base__pixel_subsampling__denominator_y(pixsub, 0) != inv_v0) ||
+        (wuffs_base__pixel_subsampling__denominator_y(pixsub, 1) != inv_v1) ||
+        (wuffs_base__pixel_subsampling__denominator_y(pixsub, 2) != inv_v2)) {
+      return wuffs_base__make_status(
+          wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+    wuffs_base__status status = wuffs_private_impl__swizzle_ycc__copy_plane(
+        dst->private_impl.planes[0], x_min_incl, x_max_excl, y_min_incl,
+        y_max_excl, src0, stride0, inv_h0, inv_v0);
+    if (status.repr) {
+      return status;
+    }
+    status = wuffs_private_impl__swizzle_ycc__copy_plane(
+        dst->private_impl.planes[1], x_min_incl, x_max_excl, y_min_incl,
+        y_max_excl, src1, stride1, inv_h1, inv_v1);
+    if (status.repr) {
+      return status;
+    }
+    return wuffs_private_impl__swizzle_ycc__copy_plane(
+        dst->private_impl.planes[2], x_min_incl, x_max_excl, y_min_incl,
+        y_max_excl, src2, stride2, inv_h2, inv_v2);
+#endif
   }
 
   // ----
@@ -1608,6 +1823,26 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
 #endif
         conv3func = &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgbx;
         break;
+      case WUFFS_BASE__PIXEL_FORMAT__BGR:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+        if (wuffs_base__cpu_arch__have_x86_avx2()) {
+          conv3func =
+              &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgr_x86_avx2;
+          break;
+        }
+#endif
+        conv3func = &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgr;
+        break;
+      case WUFFS_BASE__PIXEL_FORMAT__RGB:
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+        if (wuffs_base__cpu_arch__have_x86_avx2()) {
+          conv3func =
+              &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgb_x86_avx2;
+          break;
+        }
+#endif
+        conv3func = &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgb;
+        break;
       default:
         conv3func = &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_general;
         break;
@@ -1670,6 +1905,19 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
   memcpy(&upfuncs, &wuffs_private_impl__swizzle_ycc__upsample_funcs,
          sizeof upfuncs);
 
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    upfuncs[1][0] =
+        wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2;
+    upfuncs[1][1] =
+        wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2;
+    upfuncs[1][2] =
+        wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2;
+    upfuncs[1][3] =
+        wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2;
+  }
+#endif
+
   if ((ycc_upsampling != 0) &&
       (wuffs_private_impl__swizzle_has_triangle_upsampler(inv_h0, inv_v0) ||
        wuffs_private_impl__swizzle_has_triangle_upsampler(inv_h1, inv_v1) ||
@@ -1688,7 +1936,7 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
 #if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
 #if defined(__GNUC__) && !defined(__clang__)
     // Don't use our AVX2 implementation for GCC (but do use it for clang). For
-    // some unknown reason, GCC performs noticably better on the non-SIMD
+    // some unknown reason, GCC performs noticeably better on the non-SIMD
     // version. Possibly because GCC's auto-vectorizer is smarter (just with
     // SSE2, not AVX2) than our hand-written code, but that's just a guess.
     //
@@ -1700,6 +1948,10 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
     // versions will also auto-vectorize.
 #else
     if (wuffs_base__cpu_arch__have_x86_avx2()) {
+      upfuncs[0][1] =
+          wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2;
+      upfuncs[1][0] =
+          wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2;
       upfuncs[1][1] =
           (ycc_upsampling == 1)
               ? wuffs_private_impl__swizzle_ycc__upsample_inv_h2v2_triangle_libjpeg_x86_avx2
@@ -1718,6 +1970,28 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
         (ycc_model >= WUFFS_BASE__YCC_MODEL__RGB)
             ? &wuffs_private_impl__swizzle_cmyk__convert_4_general
             : &wuffs_private_impl__swizzle_ycck__convert_4_general;
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+    if (wuffs_base__cpu_arch__have_x86_avx2()) {
+      switch (dst->pixcfg.private_impl.pixfmt.repr) {
+        case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+        case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+        case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+          conv4func =
+              (ycc_model >= WUFFS_BASE__YCC_MODEL__RGB)
+                  ? &wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_x86_avx2
+                  : &wuffs_private_impl__swizzle_ycck__convert_4_bgrx_x86_avx2;
+          break;
+        case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+        case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+        case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+          conv4func =
+              (ycc_model >= WUFFS_BASE__YCC_MODEL__RGB)
+                  ? &wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_x86_avx2
+                  : &wuffs_private_impl__swizzle_ycck__convert_4_rgbx_x86_avx2;
+          break;
+      }
+    }
+#endif
     (*func4)(                                                 //
         dst, x_min_incl, x_max_excl, y_min_incl, y_max_excl,  //
         src0.ptr, src1.ptr, src2.ptr, src3.ptr,               //
@@ -141,6 +141,15 @@ func (g *gen) writeBuiltinCall(b *buffer, n *a.Expr, sideEffectsOnly bool, depth
 				}
 				b.writes("&empty_io_buffer")
 				return nil
+			case t.IDEmptyClosedIOReader:
+				if !g.currFunk.usesClosedIOBuffer {
+					g.currFunk.usesClosedIOBuffer = true
+					g.currFunk.bPrologue.writes("wuffs_base__io_buffer closed_io_buffer = " +
+						"wuffs_base__empty_io_buffer();\n" +
+						"closed_io_buffer.meta.closed = true;\n\n")
+				}
+				b.writes("&closed_io_buffer")
+				return nil
 			}
 		}
 	}
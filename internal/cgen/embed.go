@@ -113,6 +113,12 @@ var EmbeddedString_AuxBaseCc EmbeddedString
 //go:embed auxiliary/base.hh
 var EmbeddedString_AuxBaseHh EmbeddedString
 
+//go:embed auxiliary/animation.cc
+var embedAuxAnimationCc EmbeddedString
+
+//go:embed auxiliary/animation.hh
+var embedAuxAnimationHh EmbeddedString
+
 //go:embed auxiliary/cbor.cc
 var embedAuxCborCc EmbeddedString
 
@@ -132,12 +138,14 @@ var embedAuxJsonCc EmbeddedString
 var embedAuxJsonHh EmbeddedString
 
 var EmbeddedStrings_AuxNonBaseCcFiles = []EmbeddedString{
+	embedAuxAnimationCc,
 	embedAuxCborCc,
 	embedAuxImageCc,
 	embedAuxJsonCc,
 }
 
 var EmbeddedStrings_AuxNonBaseHhFiles = []EmbeddedString{
+	embedAuxAnimationHh,
 	embedAuxCborHh,
 	embedAuxImageHh,
 	embedAuxJsonHh,
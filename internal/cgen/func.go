@@ -31,18 +31,19 @@ type funk struct {
 	coroID        uint32
 	returnsStatus bool
 
-	varList           []*a.Var
-	varResumables     map[t.ID]bool
-	derivedVars       map[t.ID]struct{}
-	jumpTargets       map[a.Loop]string
-	activeLoops       a.LoopStack
-	coroSuspPoint     uint32
-	ioManips          uint32
-	tempW             uint32
-	tempR             uint32
-	usesEmptyIOBuffer bool
-	usesScratch       bool
-	hasGotoOK         bool
+	varList            []*a.Var
+	varResumables      map[t.ID]bool
+	derivedVars        map[t.ID]struct{}
+	jumpTargets        map[a.Loop]string
+	activeLoops        a.LoopStack
+	coroSuspPoint      uint32
+	ioManips           uint32
+	tempW              uint32
+	tempR              uint32
+	usesEmptyIOBuffer  bool
+	usesClosedIOBuffer bool
+	usesScratch        bool
+	hasGotoOK          bool
 }
 
 func (k *funk) jumpTarget(tm *t.Map, n a.Loop) (string, error) {
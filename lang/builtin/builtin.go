@@ -84,6 +84,7 @@ var FourCCs = [...][2]string{
 	{"TOML", "Tom's Obvious Minimal Language"},
 	{"WAVE", "Waveform"},
 	{"WBMP", "Wireless Bitmap"},
+	{"WEBM", "Web Media"},
 	{"WEBP", "Web Picture"},
 	{"WOFF", "Web Open Font Format"},
 	{"XML ", "Extensible Markup Language"},
@@ -161,6 +162,7 @@ var Consts = [...]struct {
 	{t.IDU32, "1", "QUIRK_IGNORE_CHECKSUM"},
 	{t.IDU32, "2", "QUIRK_QUALITY"},
 	{t.IDU32, "3", "QUIRK_SOURCE_LENGTH"},
+	{t.IDU32, "4", "QUIRK_SEEK_PAST_PIXEL_DATA"},
 
 	// ----
 
@@ -259,6 +261,7 @@ var Consts = [...]struct {
 var Statuses = [...]string{
 	// Notes.
 	`"@I/O redirect"`,
+	`"@I/O seek"`,
 	`"@end of data"`,
 	`"@metadata reported"`,
 
@@ -396,6 +399,7 @@ var funcsOther = [...]string{
 	// ---- utility
 
 	"utility.cpu_arch_is_32_bit() bool",
+	"utility.empty_closed_io_reader() io_reader",
 	"utility.empty_io_reader() io_reader",
 	"utility.empty_io_writer() io_writer",
 	"utility.empty_range_ii_u32() range_ii_u32",
@@ -700,7 +704,10 @@ var funcsOther = [...]string{
 	// ---- pixel_format
 
 	"pixel_format.bits_per_pixel() u32[..= 256]",
+	"pixel_format.coloration() u32[..= 3]",
 	"pixel_format.default_background_color() u32",
+	"pixel_format.is_planar() bool",
+	"pixel_format.transparency() u32[..= 3]",
 
 	// ---- pixel_swizzler
 
@@ -751,6 +758,10 @@ var funcsOther = [...]string{
 		"ycc_upsampling: u8," +
 		"scratch_buffer_2k: slice u8) status",
 
+	// ---- rect_ie_u32
+
+	"rect_ie_u32.is_empty() bool",
+
 	// ---- arm_crc32_utility
 
 	"arm_crc32_utility.make_u32(a: u32) arm_crc32_u32",
@@ -864,7 +875,10 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_add_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_add_epi64(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_add_epi8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_adds_epi8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_adds_epu8(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_and_si128(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_andnot_si128(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_avg_epu16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_avg_epu8(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_blend_epi16(b: x86_m128i, imm8: u32) x86_m128i",
@@ -892,9 +906,12 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_min_epu16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_min_epu32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_min_epu8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_mulhi_epi16(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_mullo_epi16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_mullo_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_or_si128(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_packs_epi16(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_packs_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_packus_epi16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_sad_epu8(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_shuffle_epi32(imm8: u32) x86_m128i",
@@ -903,6 +920,8 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_slli_epi32(imm8: u32) x86_m128i",
 	"x86_m128i._mm_slli_epi64(imm8: u32) x86_m128i",
 	"x86_m128i._mm_slli_si128(imm8: u32) x86_m128i",
+	"x86_m128i._mm_srai_epi16(imm8: u32) x86_m128i",
+	"x86_m128i._mm_srai_epi32(imm8: u32) x86_m128i",
 	"x86_m128i._mm_srli_epi16(imm8: u32) x86_m128i",
 	"x86_m128i._mm_srli_epi32(imm8: u32) x86_m128i",
 	"x86_m128i._mm_srli_epi64(imm8: u32) x86_m128i",
@@ -911,6 +930,9 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_sub_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_sub_epi64(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_sub_epi8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_subs_epi8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_subs_epu16(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_subs_epu8(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_unpackhi_epi16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_unpackhi_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_unpackhi_epi64(b: x86_m128i) x86_m128i",
@@ -967,21 +989,26 @@ var funcsOther = [...]string{
 	"x86_m256i._mm256_add_epi32(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_add_epi64(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_add_epi8(b: x86_m256i) x86_m256i",
+	"x86_m256i._mm256_adds_epu8(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_and_si256(b: x86_m256i) x86_m256i",
+	"x86_m256i._mm256_blendv_epi8(b: x86_m256i, mask: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_castsi256_si128() x86_m128i",
 	"x86_m256i._mm256_extract_epi64(index: u32) u64",
 	"x86_m256i._mm256_extracti128_si256(imm8: u32) x86_m128i",
 	"x86_m256i._mm256_inserti128_si256(b: x86_m128i, imm8: u32) x86_m256i",
 	"x86_m256i._mm256_madd_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_maddubs_epi16(b: x86_m256i) x86_m256i",
+	"x86_m256i._mm256_mulhi_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_mullo_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_or_si256(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_packs_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_packs_epi32(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_permute2x128_si256(b: x86_m256i, imm8: u32) x86_m256i",
 	"x86_m256i._mm256_permute4x64_epi64(imm8: u32) x86_m256i",
+	"x86_m256i._mm256_permutevar8x32_epi32(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_sad_epu8(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_shuffle_epi32(imm8: u32) x86_m256i",
+	"x86_m256i._mm256_shuffle_epi8(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_sign_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_slli_epi16(imm8: u32) x86_m256i",
 	"x86_m256i._mm256_slli_epi32(imm8: u32) x86_m256i",
@@ -995,10 +1022,12 @@ var funcsOther = [...]string{
 	"x86_m256i._mm256_srli_epi32(imm8: u32) x86_m256i",
 	"x86_m256i._mm256_srli_epi64(imm8: u32) x86_m256i",
 	"x86_m256i._mm256_srli_si256(imm8: u32) x86_m256i",
+	"x86_m256i._mm256_srlv_epi32(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_sub_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_sub_epi32(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_sub_epi64(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_sub_epi8(b: x86_m256i) x86_m256i",
+	"x86_m256i._mm256_subs_epu8(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_testz_si256(b: x86_m256i) u32",
 	"x86_m256i._mm256_unpackhi_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_unpackhi_epi32(b: x86_m256i) x86_m256i",
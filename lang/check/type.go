@@ -650,8 +650,12 @@ func (q *checker) tcheckExprCall(n *a.Expr, depth uint32) error {
 			n.Str(q.tm), ne, f.QQID().Str(q.tm), fe)
 	}
 	if f.HasChooseCPUArch() {
-		return fmt.Errorf(`check: cannot call cpu_arch function %q directly, only via "choose"`,
-			f.QQID().Str(q.tm))
+		// A cpu_arch function can call another directly, provided that the
+		// caller's CPU architecture requirements imply the callee's.
+		if need := calcCPUArchBits(f); (need & calcCPUArchBits(q.astFunc)) != need {
+			return fmt.Errorf(`check: cannot call cpu_arch function %q directly, only via "choose"`,
+				f.QQID().Str(q.tm))
+		}
 	}
 
 	genericType1 := (*a.TypeExpr)(nil)
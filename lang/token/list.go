@@ -494,6 +494,8 @@ const (
 	IDTokenWriter     = ID(0x12A)
 	IDUtility         = ID(0x12B)
 
+	IDEmptyClosedIOReader = ID(0x12C)
+
 	IDRangeIEU32 = ID(0x130)
 	IDRangeIIU32 = ID(0x131)
 	IDRangeIEU64 = ID(0x132)
@@ -945,6 +947,8 @@ var builtInsByID = [nBuiltInIDs]string{
 	IDTokenWriter:     "token_writer",
 	IDUtility:         "utility",
 
+	IDEmptyClosedIOReader: "empty_closed_io_reader",
+
 	IDRangeIEU32: "range_ie_u32",
 	IDRangeIIU32: "range_ii_u32",
 	IDRangeIEU64: "range_ie_u64",
@@ -83,7 +83,22 @@ func (dst *BlockI16) ForwardDCTFrom(src *BlockU8) {
 		srcI64[i] = int64(v) - 0x80
 	}
 
-	// Iterate in DCT space (outer) and XY space (inner).
+	// The 2-dimensional FDCT is separable. First transform each row (from x
+	// to u), as 16.16 fixed point values, then each column (from y to v).
+	// This is 8 times fewer multiplications than the direct sum over (x, y)
+	// for each (u, v) but, as integer multiplication distributes over
+	// addition, computes exactly the same sum32 values.
+	rows16 := [64]int64{}
+	for y := 0; y < 8; y++ {
+		for u := 0; u < 8; u++ {
+			sum16 := int64(0)
+			for x := 0; x < 8; x++ {
+				sum16 += srcI64[(8*y)+x] * int64(cosines[(((2*x)+1)*u)&31])
+			}
+			rows16[(8*y)+u] = sum16
+		}
+	}
+
 	for v := 0; v < 8; v++ {
 		halfAlphaV16 := ifElse(v == 0, fixedPointInv2Sqrt2, fixedPointHalf)
 		for u := 0; u < 8; u++ {
@@ -94,15 +109,8 @@ func (dst *BlockI16) ForwardDCTFrom(src *BlockU8) {
 			sum32 := int64(0)
 
 			for y := 0; y < 8; y++ {
-				for x := 0; x < 8; x++ {
-					// c32 is two 16.16 fixed point values multiplied together,
-					// as a 32.32 fixed point value.
-					//
-					// sum32 accumulates a 32.32 fixed point value.
-					c32 := int64(cosines[(((2*x)+1)*u)&31]) *
-						int64(cosines[(((2*y)+1)*v)&31])
-					sum32 += srcI64[(8*y)+x] * c32
-				}
+				// sum32 accumulates a 32.32 fixed point value.
+				sum32 += rows16[(8*y)+u] * int64(cosines[(((2*y)+1)*v)&31])
 			}
 
 			// Calculate alphasSum32 as 32.32 fixed point.
@@ -88,6 +88,14 @@ type EncoderOptions struct {
 	// is equivalent to using DefaultQuality.
 	QuantizationFactors *Array2QuantizationFactors
 
+	// RestartInterval is the number of MCUs (Minimum Coded Units) between
+	// RSTn (restart) markers. Zero means to not emit any restart markers.
+	//
+	// Restart markers reset the entropy coder's state. A decoder can use them
+	// to resynchronize after a corrupted segment, or to decode the segments
+	// between them in parallel.
+	RestartInterval uint16
+
 	// There may be other fields added in the future.
 }
 
@@ -123,11 +131,15 @@ type Encoder struct {
 
 	quants Array2QuantizationFactors
 
-	// The fields above occupy 148 bytes. Each Reset or AddN call, in the worst
+	restartInterval  uint16
+	restartCountdown uint16
+	restartMarker    uint16
+
+	// The fields above occupy 154 bytes. Each Reset or AddN call, in the worst
 	// case, emits not much more than 2688 bytes. We round sizeof(Encoder) up
 	// to be 3072, which is 1.5 times a power of 2.
 
-	buf [3072 - 148]byte
+	buf [3072 - 154]byte
 }
 
 // Reset makes an Encoder ready to use (ready to make AddN calls), for encoding
@@ -158,6 +170,14 @@ func (e *Encoder) Reset(w io.Writer, colorType ColorType, width int, height int,
 		e.quants = *q
 	}
 
+	if options == nil {
+		e.restartInterval = 0
+	} else {
+		e.restartInterval = options.RestartInterval
+	}
+	e.restartCountdown = e.restartInterval
+	e.restartMarker = 0
+
 	e.hasReturnedError = false
 	e.colorType = colorType
 	e.prevDC[0] = 0
@@ -177,6 +197,7 @@ func (e *Encoder) Reset(w io.Writer, colorType ColorType, width int, height int,
 	bufIndex = e.encodeDQT(bufIndex)
 	bufIndex = e.encodeSOF0(bufIndex, width, height)
 	bufIndex = e.encodeDHT(bufIndex)
+	bufIndex = e.encodeDRI(bufIndex)
 	bufIndex = e.encodeSOSHeader(bufIndex)
 	if _, err := w.Write(e.buf[:bufIndex]); err != nil {
 		e.hasReturnedError = true
@@ -247,7 +268,17 @@ func (e *Encoder) addN(w io.Writer, blocks []BlockI16) error {
 	e.numAddsRemaining--
 
 	// In terms of worst case number of bytes emitted, the up-to-six
-	// encodeBlock calls can emit 2688 bytes (6 * 448 bytes).
+	// encodeBlock calls can emit 2688 bytes (6 * 448 bytes). A restart marker
+	// adds up to 3 more bytes.
+
+	bufIndex := 0
+	if e.restartInterval > 0 {
+		if e.restartCountdown == 0 {
+			bufIndex = e.encodeRST(bufIndex)
+			e.restartCountdown = e.restartInterval
+		}
+		e.restartCountdown--
+	}
 
 	whichComponents := ""
 	switch ColorType(len(blocks)) {
@@ -259,7 +290,6 @@ func (e *Encoder) addN(w io.Writer, blocks []BlockI16) error {
 		whichComponents = "\x00\x00\x00\x00\x01\x02"
 	}
 
-	bufIndex := 0
 	for i := range blocks {
 		bufIndex = e.encodeBlock(bufIndex, whichComponents[i], &blocks[i])
 	}
@@ -359,6 +389,35 @@ func (e *Encoder) encodeDHT(bufIndex int) int {
 	return bufIndex + n
 }
 
+func (e *Encoder) encodeDRI(bufIndex int) int {
+	if e.restartInterval == 0 {
+		return bufIndex
+	}
+	e.buf[bufIndex+0] = 0xFF
+	e.buf[bufIndex+1] = 0xDD
+	e.buf[bufIndex+2] = 0x00
+	e.buf[bufIndex+3] = 0x04 // Payload length.
+	e.buf[bufIndex+4] = byte(e.restartInterval >> 8)
+	e.buf[bufIndex+5] = byte(e.restartInterval >> 0)
+	return bufIndex + 6
+}
+
+// encodeRST pads the bitstream to a byte boundary (with 1 bits) and then emits
+// the next RSTn marker, cycling from RST0 to RST7. It also resets the DC
+// predictors, per section F.2.1.3.1 of the spec.
+func (e *Encoder) encodeRST(bufIndex int) int {
+	bufIndex = e.emitBits(bufIndex, 0x7F, 7)
+	e.bitsV = 0
+	e.bitsN = 0
+	e.buf[bufIndex+0] = 0xFF
+	e.buf[bufIndex+1] = 0xD0 | byte(e.restartMarker&7)
+	e.restartMarker++
+	e.prevDC[0] = 0
+	e.prevDC[1] = 0
+	e.prevDC[2] = 0
+	return bufIndex + 2
+}
+
 func (e *Encoder) encodeSOSHeader(bufIndex int) int {
 	s := ""
 	if e.colorType == ColorTypeGray {
@@ -78,11 +78,12 @@ func checkPixelApproxEqual(tt *testing.T, dst image.RGBA64Image, src image.RGBA6
 	}
 }
 
-func testLowLevelJpegEncodeJpegDecode(tt *testing.T, src image.RGBA64Image, colorType ColorType) {
+func testLowLevelJpegEncodeJpegDecode(tt *testing.T, src image.RGBA64Image, colorType ColorType, restartInterval uint16) {
 	quants := Array2QuantizationFactors{}
 	quants.SetToStandardValues(MaximumQuality)
 	opts := &EncoderOptions{
 		QuantizationFactors: &quants,
+		RestartInterval:     restartInterval,
 	}
 
 	bounds := src.Bounds()
@@ -122,6 +123,20 @@ func testLowLevelJpegEncodeJpegDecode(tt *testing.T, src image.RGBA64Image, colo
 		tt.Fatalf("unexpected colorType: %v", colorType)
 	}
 
+	if restartInterval > 0 {
+		numMCUs := ((bounds.Dx() + 7) / 8) * ((bounds.Dy() + 7) / 8)
+		wantRSTs := (numMCUs - 1) / int(restartInterval)
+		gotRSTs := 0
+		for i, c := range buf.Bytes()[:buf.Len()-1] {
+			if (c == 0xFF) && ((buf.Bytes()[i+1] & 0xF8) == 0xD0) {
+				gotRSTs++
+			}
+		}
+		if gotRSTs != wantRSTs {
+			tt.Fatalf("RSTn markers: got %d, want %d", gotRSTs, wantRSTs)
+		}
+	}
+
 	dst, err := jpeg.Decode(buf)
 	if err != nil {
 		tt.Fatalf("jpeg.Decode: %v", err)
@@ -139,7 +154,7 @@ func testLowLevelJpegEncodeJpegDecode(tt *testing.T, src image.RGBA64Image, colo
 func TestColorTypeGray(tt *testing.T) {
 	src := image.NewGray(image.Rect(0, 0, 8, 8))
 	copy(src.Pix, pjw8x8[:])
-	testLowLevelJpegEncodeJpegDecode(tt, src, ColorTypeGray)
+	testLowLevelJpegEncodeJpegDecode(tt, src, ColorTypeGray, 0)
 }
 
 func TestColorTypeYCbCr444(tt *testing.T) {
@@ -155,7 +170,24 @@ func TestColorTypeYCbCr444(tt *testing.T) {
 			src.Cr[i] = 0xAA
 		}
 	}
-	testLowLevelJpegEncodeJpegDecode(tt, src, ColorTypeYCbCr444)
+	testLowLevelJpegEncodeJpegDecode(tt, src, ColorTypeYCbCr444, 0)
+}
+
+func TestRestartInterval(tt *testing.T) {
+	const width, height = 40, 24
+	src := image.NewYCbCr(image.Rect(0, 0, width, height), image.YCbCrSubsampleRatio444)
+	bounds := src.Bounds()
+	for y := bounds.Min.Y; y < bounds.Max.Y; y++ {
+		for x := bounds.Min.X; x < bounds.Max.X; x++ {
+			i := (width * y) + x
+			src.Y[i] = pjw16x16[(16*(y&15))+(x&15)]
+			src.Cb[i] = uint8(i)
+			src.Cr[i] = uint8(7 * y)
+		}
+	}
+	for _, restartInterval := range []uint16{1, 2, 4, 15} {
+		testLowLevelJpegEncodeJpegDecode(tt, src, ColorTypeYCbCr444, restartInterval)
+	}
 }
 
 // TestWikipediaDCT confirms that we can reproduce the FDCT computation from
@@ -483,3 +515,48 @@ func outsideTolerance(i uint8, j uint8, tolerance int) bool {
 	delta := int(i) - int(j)
 	return (delta < -tolerance) || (+tolerance < delta)
 }
+
+func BenchmarkForwardDCT(b *testing.B) {
+	dst := BlockI16{}
+	b.SetBytes(64)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		dst.ForwardDCTFrom(&pjw8x8)
+	}
+}
+
+func BenchmarkEncodeYCbCr420(b *testing.B) {
+	const width, height = 256, 256
+	src := image.NewRGBA(image.Rect(0, 0, width, height))
+	for y := 0; y < height; y++ {
+		for x := 0; x < width; x++ {
+			i := (4 * width * y) + (4 * x)
+			src.Pix[i+0] = pjw16x16[(16*(y&15))+(x&15)]
+			src.Pix[i+1] = uint8(x)
+			src.Pix[i+2] = uint8(y)
+			src.Pix[i+3] = 0xFF
+		}
+	}
+
+	enc := Encoder{}
+	srcU8s := Array6BlockU8{}
+	srcI16s := Array6BlockI16{}
+	b.SetBytes(width * height * 4)
+	b.ReportAllocs()
+	b.ResetTimer()
+	for i := 0; i < b.N; i++ {
+		if err := enc.Reset(io.Discard, ColorTypeYCbCr420, width, height, nil); err != nil {
+			b.Fatalf("enc.Reset: %v", err)
+		}
+		for y := 0; y < height; y += 16 {
+			for x := 0; x < width; x += 16 {
+				srcU8s.ExtractYCbCrFrom(src, x, y)
+				srcI16s.ForwardDCTFrom(&srcU8s)
+				if err := enc.Add6(io.Discard, &srcI16s); err != nil {
+					b.Fatalf("enc.Add6: %v", err)
+				}
+			}
+		}
+	}
+}
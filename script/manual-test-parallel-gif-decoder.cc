@@ -0,0 +1,337 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// ----------------
+
+// manual-test-parallel-gif-decoder tests that wuffs_aux::ParallelGifDecoder
+// produces the same frames as wuffs_aux::AnimationDecoder, for every GIF file
+// given on the command line (or found recursively in the directories given).
+//
+// For each of a few num_threads values (so that batches of frames start and
+// end at different frames), the two decoders must agree on every frame's
+// config and composited canvas, and on the number of frames. If either
+// decoder hits an error, the other must hit one at the same frame.
+//
+// To run (from the script directory):
+//
+// $CXX -O2 -pthread manual-test-parallel-gif-decoder.cc && ./a.out ../test/data
+//
+// for a C++ compiler $CXX, such as clang++ or g++.
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__STATIC_FUNCTIONS macro is optional, but when
+// combined with WUFFS_IMPLEMENTATION, it demonstrates making all of Wuffs'
+// functions have static storage.
+//
+// This can help the compiler ignore or discard unused code, which can produce
+// faster compiles and smaller binaries. Other motivations are discussed in the
+// "ALLOW STATIC IMPLEMENTATION" section of
+// https://raw.githubusercontent.com/nothings/stb/master/docs/stb_howto.txt
+#define WUFFS_CONFIG__STATIC_FUNCTIONS
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__ANIMATION
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__GIF
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../release/c/wuffs-unsupported-snapshot.c"
+
+// ----
+
+static int g_num_files_processed;
+
+static struct {
+  char buf[PATH_MAX];
+  size_t len;
+} g_relative_cwd;
+
+// ----
+
+static const char skipped[] = "skipped";
+
+static const uint32_t g_num_threads[] = {1, 2, 3, 8};
+
+// g_message holds the failure message for the file being processed.
+static std::string g_message;
+
+static bool  //
+frame_configs_equal(const wuffs_base__frame_config& a,
+                    const wuffs_base__frame_config& b) {
+  wuffs_base__rect_ie_u32 ra = a.bounds();
+  wuffs_base__rect_ie_u32 rb = b.bounds();
+  return (a.index() == b.index()) && (a.duration() == b.duration()) &&
+         (a.io_position() == b.io_position()) &&
+         (a.disposal() == b.disposal()) &&
+         (a.overwrite_instead_of_blend() == b.overwrite_instead_of_blend()) &&
+         ra.equals(rb);
+}
+
+static bool  //
+canvases_equal(const wuffs_base__pixel_buffer& a,
+               const wuffs_base__pixel_buffer& b) {
+  wuffs_base__table_u8 ta = const_cast<wuffs_base__pixel_buffer&>(a).plane(0);
+  wuffs_base__table_u8 tb = const_cast<wuffs_base__pixel_buffer&>(b).plane(0);
+  if ((ta.width != tb.width) || (ta.height != tb.height)) {
+    return false;
+  }
+  for (size_t y = 0; y < ta.height; y++) {
+    if (memcmp(ta.ptr + (y * ta.stride), tb.ptr + (y * tb.stride), ta.width)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static const char*  //
+handle_num_threads(const uint8_t* ptr, size_t len, uint32_t num_threads) {
+  wuffs_aux::AnimationDecoder want(ptr, len);
+  wuffs_aux::ParallelGifDecoder have(ptr, len, num_threads);
+  std::string want_msg = want.DecodeImageConfig();
+  std::string have_msg = have.DecodeImageConfig();
+  if (want_msg.empty() != have_msg.empty()) {
+    g_message = "num_threads=" + std::to_string(num_threads) +
+                ": DecodeImageConfig: have \"" + have_msg + "\", want \"" +
+                want_msg + "\"";
+    return g_message.c_str();
+  } else if (!want_msg.empty()) {
+    return skipped;
+  }
+
+  for (uint64_t i = 0; true; i++) {
+    want_msg = want.SeekFrame(i);
+    have_msg = have.DecodeNextFrame();
+    bool want_end = want_msg == wuffs_aux::AnimationDecoder_EndOfAnimation;
+    bool have_end = have_msg == wuffs_aux::ParallelGifDecoder_EndOfAnimation;
+    std::string prefix = "num_threads=" + std::to_string(num_threads) +
+                         ", frame #" + std::to_string(i) + ": ";
+    if ((want_msg.empty() != have_msg.empty()) || (want_end != have_end)) {
+      g_message = prefix + "have \"" + have_msg + "\", want \"" + want_msg +
+                  "\"";
+      return g_message.c_str();
+    } else if (!want_msg.empty()) {
+      // Both decoders reached the end of the animation or hit an error.
+      return nullptr;
+    } else if (!frame_configs_equal(have.FrameConfig(), want.FrameConfig())) {
+      g_message = prefix + "frame configs differ";
+      return g_message.c_str();
+    } else if (!canvases_equal(have.Canvas(), want.Canvas())) {
+      g_message = prefix + "canvases differ";
+      return g_message.c_str();
+    }
+  }
+}
+
+static const char*  //
+handle(const uint8_t* ptr, size_t len) {
+  auto src = wuffs_base__ptr_u8__reader(const_cast<uint8_t*>(ptr), len, true);
+  int32_t fourcc = wuffs_base__magic_number_guess_fourcc(src.reader_slice(),
+                                                         src.meta.closed);
+  if (fourcc != WUFFS_BASE__FOURCC__GIF) {
+    return skipped;
+  }
+
+  for (uint32_t num_threads : g_num_threads) {
+    const char* msg = handle_num_threads(ptr, len, num_threads);
+    if (msg) {
+      return msg;
+    }
+  }
+  return nullptr;
+}
+
+// ----
+
+static int  //
+visit(char* filename);
+
+static int  //
+visit_dir(int fd) {
+  int cwd_fd = open(".", O_RDONLY, 0);
+  if (fchdir(fd)) {
+    printf("failed\n");
+    fprintf(stderr, "FAIL: fchdir: %s\n", strerror(errno));
+    return 1;
+  }
+
+  DIR* d = fdopendir(fd);
+  if (!d) {
+    printf("failed\n");
+    fprintf(stderr, "FAIL: fdopendir: %s\n", strerror(errno));
+    return 1;
+  }
+
+  printf("dir\n");
+  while (true) {
+    struct dirent* e = readdir(d);
+    if (!e) {
+      break;
+    }
+    if ((e->d_name[0] == '\x00') || (e->d_name[0] == '.')) {
+      continue;
+    }
+    int v = visit(e->d_name);
+    if (v) {
+      return v;
+    }
+  }
+
+  if (closedir(d)) {
+    fprintf(stderr, "FAIL: closedir: %s\n", strerror(errno));
+    return 1;
+  }
+  if (fchdir(cwd_fd)) {
+    fprintf(stderr, "FAIL: fchdir: %s\n", strerror(errno));
+    return 1;
+  }
+  if (close(cwd_fd)) {
+    fprintf(stderr, "FAIL: close: %s\n", strerror(errno));
+    return 1;
+  }
+  return 0;
+}
+
+static int  //
+visit_reg(int fd, off_t size) {
+  if ((size < 0) || (0x7FFFFFFF < size)) {
+    printf("failed\n");
+    fprintf(stderr, "FAIL: file size out of bounds");
+    return 1;
+  }
+
+  void* data = NULL;
+  if (size > 0) {
+    data = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      printf("failed\n");
+      fprintf(stderr, "FAIL: mmap: %s\n", strerror(errno));
+      return 1;
+    }
+  }
+
+  const char* msg = handle((const uint8_t*)(data), size);
+  if (msg) {
+    printf("%s\n", msg);
+  } else {
+    printf("ok\n");
+  }
+
+  if ((size > 0) && munmap(data, size)) {
+    fprintf(stderr, "FAIL: mmap: %s\n", strerror(errno));
+    return 1;
+  }
+  if (close(fd)) {
+    fprintf(stderr, "FAIL: close: %s\n", strerror(errno));
+    return 1;
+  }
+  return (msg && (msg != skipped)) ? 1 : 0;
+}
+
+static int  //
+visit(char* filename) {
+  g_num_files_processed++;
+  if (!filename || (filename[0] == '\x00')) {
+    fprintf(stderr, "FAIL: invalid filename\n");
+    return 1;
+  }
+  int n = printf("- %s%s", g_relative_cwd.buf, filename);
+  printf("%*s", (60 > n) ? (60 - n) : 1, "");
+  fflush(stdout);
+
+  struct stat z;
+  int fd = open(filename, O_RDONLY, 0);
+  if (fd == -1) {
+    printf("failed\n");
+    fprintf(stderr, "FAIL: open: %s\n", strerror(errno));
+    return 1;
+  }
+  if (fstat(fd, &z)) {
+    printf("failed\n");
+    fprintf(stderr, "FAIL: fstat: %s\n", strerror(errno));
+    return 1;
+  }
+
+  if (S_ISREG(z.st_mode)) {
+    return visit_reg(fd, z.st_size);
+  } else if (!S_ISDIR(z.st_mode)) {
+    printf("skipped\n");
+    return 0;
+  }
+
+  size_t old_len = g_relative_cwd.len;
+  size_t filename_len = strlen(filename);
+  size_t new_len = old_len + strlen(filename);
+  bool slash = filename[filename_len - 1] != '/';
+  if (slash) {
+    new_len++;
+  }
+  if ((filename_len >= PATH_MAX) || (new_len >= PATH_MAX)) {
+    printf("failed\n");
+    fprintf(stderr, "FAIL: path is too long\n");
+    return 1;
+  }
+  memcpy(g_relative_cwd.buf + old_len, filename, filename_len);
+
+  if (slash) {
+    g_relative_cwd.buf[new_len - 1] = '/';
+  }
+  g_relative_cwd.buf[new_len] = '\x00';
+  g_relative_cwd.len = new_len;
+
+  int v = visit_dir(fd);
+
+  g_relative_cwd.buf[old_len] = '\x00';
+  g_relative_cwd.len = old_len;
+  return v;
+}
+
+int  //
+main(int argc, char** argv) {
+  g_num_files_processed = 0;
+  g_relative_cwd.len = 0;
+
+  for (int i = 1; i < argc; i++) {
+    int v = visit(argv[i]);
+    if (v) {
+      return v;
+    }
+  }
+
+  printf("PASS: %d files processed\n", g_num_files_processed);
+  return 0;
+}
@@ -11,7 +11,7 @@
 //go:build ignore
 // +build ignore
 
-// Deprecated: unused as of commit 695a6815 "Remove gif.config_decoder".
+// It is used by std/jpeg/decode_mcu_default.wuffs.
 
 // TODO: consider renaming this from script/preprocess-wuffs.go to
 // cmd/wuffspreprocess, making it a "go install"able command line tool.
@@ -30,6 +30,9 @@
 
 #define WUFFS_MIMICLIB_ZLIB_DOES_NOT_SUPPORT_DICTIONARIES 1
 
+// We deliberately do not define the
+// WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE macro.
+
 uint32_t global_mimiclib_deflate_unused_u32;
 
 typedef enum libdeflate_result (*libdeflate_decompress_func)(
@@ -169,6 +172,58 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
   return "libdeflate does not implement zlib dictionaries";
 }
 
+typedef size_t (*libdeflate_compress_func)(struct libdeflate_compressor*,
+                                           const void*,
+                                           size_t,
+                                           void*,
+                                           size_t);
+
+const char*  //
+mimic_deflate_gzip_zlib_encode(wuffs_base__io_buffer* dst,
+                               wuffs_base__io_buffer* src,
+                               int level,
+                               libdeflate_compress_func func) {
+  struct libdeflate_compressor* enc = libdeflate_alloc_compressor(level);
+  if (!enc) {
+    return "libdeflate: alloc failed";
+  }
+  size_t n_dst = (*func)(enc, wuffs_base__io_buffer__reader_pointer(src),
+                         wuffs_base__io_buffer__reader_length(src),
+                         wuffs_base__io_buffer__writer_pointer(dst),
+                         wuffs_base__io_buffer__writer_length(dst));
+  libdeflate_free_compressor(enc);
+  if (n_dst == 0) {
+    return "libdeflate: insufficient space";
+  }
+  dst->meta.wi += n_dst;
+  src->meta.ri = src->meta.wi;
+  return NULL;
+}
+
+const char*  //
+mimic_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     int level) {
+  return mimic_deflate_gzip_zlib_encode(dst, src, level,
+                                        &libdeflate_deflate_compress);
+}
+
+const char*  //
+mimic_gzip_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  int level) {
+  return mimic_deflate_gzip_zlib_encode(dst, src, level,
+                                        &libdeflate_gzip_compress);
+}
+
+const char*  //
+mimic_zlib_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  int level) {
+  return mimic_deflate_gzip_zlib_encode(dst, src, level,
+                                        &libdeflate_zlib_compress);
+}
+
 // -------------------------------- WUFFS_MIMICLIB_USE_XXX_INSTEAD_OF_ZLIB
 #elif defined(WUFFS_MIMICLIB_USE_MINIZ_INSTEAD_OF_ZLIB)
 #include "/path/to/your/copy/of/github.com/richgel999/miniz/miniz_tinfl.c"
@@ -178,6 +233,8 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
 
 #define WUFFS_MIMICLIB_ZLIB_DOES_NOT_SUPPORT_DICTIONARIES 1
 
+#define WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE 1
+
 const char*  //
 mimic_bench_adler32(wuffs_base__io_buffer* dst,
                     wuffs_base__io_buffer* src,
@@ -269,6 +326,9 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
 // We deliberately do not define the
 // WUFFS_MIMICLIB_ZLIB_DOES_NOT_SUPPORT_DICTIONARIES macro.
 
+// We deliberately do not define the
+// WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE macro.
+
 uint32_t global_mimiclib_deflate_unused_u32;
 
 const char*  //
@@ -464,5 +524,90 @@ mimic_zlib_decode_with_dictionary(wuffs_base__io_buffer* dst,
                                         UINT64_MAX, zlib_flavor_zlib);
 }
 
+const char*  //
+mimic_deflate_gzip_zlib_encode(wuffs_base__io_buffer* dst,
+                               wuffs_base__io_buffer* src,
+                               int level,
+                               zlib_flavor flavor) {
+  const char* ret = NULL;
+  if (dst->data.len > UINT_MAX) {
+    ret = "dst length is too large";
+    goto cleanup0;
+  }
+  if (src->data.len > UINT_MAX) {
+    ret = "src length is too large";
+    goto cleanup0;
+  }
+
+  // See deflateInit2 in the zlib manual, or in zlib.h, for details about how
+  // the window_bits int also encodes the wire format wrapper.
+  int window_bits = 0;
+  switch (flavor) {
+    case zlib_flavor_raw:
+      window_bits = -15;
+      break;
+    case zlib_flavor_gzip:
+      window_bits = +15 | 16;
+      break;
+    case zlib_flavor_zlib:
+      window_bits = +15;
+      break;
+    default:
+      ret = "invalid zlib_flavor";
+      goto cleanup0;
+  }
+  z_stream z = {0};
+  int di2_err =
+      deflateInit2(&z, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY);
+  if (di2_err != Z_OK) {
+    ret = "deflateInit2 failed";
+    goto cleanup0;
+  }
+
+  z.next_in = src->data.ptr + src->meta.ri;
+  z.avail_in = src->meta.wi - src->meta.ri;
+  uInt initial_avail_in = z.avail_in;
+
+  z.next_out = dst->data.ptr + dst->meta.wi;
+  z.avail_out = dst->data.len - dst->meta.wi;
+  uInt initial_avail_out = z.avail_out;
+
+  int d_err = deflate(&z, Z_FINISH);
+  src->meta.ri += initial_avail_in - z.avail_in;
+  dst->meta.wi += initial_avail_out - z.avail_out;
+  if (d_err != Z_STREAM_END) {
+    ret = "deflate failed";
+  }
+
+  int de_err = deflateEnd(&z);
+  if ((de_err != Z_OK) && !ret) {
+    ret = "deflateEnd failed";
+  }
+
+cleanup0:;
+  return ret;
+}
+
+const char*  //
+mimic_deflate_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__io_buffer* src,
+                     int level) {
+  return mimic_deflate_gzip_zlib_encode(dst, src, level, zlib_flavor_raw);
+}
+
+const char*  //
+mimic_gzip_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  int level) {
+  return mimic_deflate_gzip_zlib_encode(dst, src, level, zlib_flavor_gzip);
+}
+
+const char*  //
+mimic_zlib_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  int level) {
+  return mimic_deflate_gzip_zlib_encode(dst, src, level, zlib_flavor_zlib);
+}
+
 #endif
 // -------------------------------- WUFFS_MIMICLIB_USE_XXX_INSTEAD_OF_ZLIB
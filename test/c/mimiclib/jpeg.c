@@ -66,6 +66,9 @@ mimic_jpeg_decode(uint64_t* n_bytes_out,
     case WUFFS_BASE__PIXEL_FORMAT__Y:
       cinfo.out_color_space = JCS_GRAYSCALE;
       break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      cinfo.out_color_space = JCS_EXT_BGR;
+      break;
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       cinfo.out_color_space = JCS_EXT_BGRA;
       break;
@@ -45,6 +45,8 @@
 // December 2020, fixed Adler-32 but not CRC-32.
 #define WUFFS_MIMICLIB_PNG_DOES_NOT_VERIFY_FINAL_IDAT_CHECKSUMS 1
 
+#define WUFFS_MIMICLIB_PNG_DOES_NOT_SUPPORT_ENCODE 1
+
 const char*  //
 mimic_png_decode(uint64_t* n_bytes_out,
                  wuffs_base__io_buffer* dst,
@@ -137,6 +139,8 @@ cleanup0:;
 
 #define WUFFS_MIMICLIB_PNG_DOES_NOT_SUPPORT_QUIRK_IGNORE_CHECKSUM 1
 
+#define WUFFS_MIMICLIB_PNG_DOES_NOT_SUPPORT_ENCODE 1
+
 // We deliberately do not define the
 // WUFFS_MIMICLIB_PNG_DOES_NOT_VERIFY_CHECKSUM macro.
 
@@ -236,6 +240,8 @@ cleanup0:;
 // We deliberately do not define the
 // WUFFS_MIMICLIB_PNG_DOES_NOT_VERIFY_FINAL_IDAT_CHECKSUMS macro.
 
+#define WUFFS_MIMICLIB_PNG_DOES_NOT_SUPPORT_ENCODE 1
+
 #define mimic_png_decode mimic_stb_decode
 #include "./stb.c"
 
@@ -328,5 +334,48 @@ cleanup0:;
   return ret;
 }
 
+const char*  //
+mimic_png_encode(uint64_t* n_bytes_out,
+                 wuffs_base__io_buffer* dst,
+                 wuffs_base__pixel_buffer* src) {
+  png_image pi;
+  memset(&pi, 0, (sizeof pi));
+  pi.version = PNG_IMAGE_VERSION;
+  pi.width = wuffs_base__pixel_config__width(&src->pixcfg);
+  pi.height = wuffs_base__pixel_config__height(&src->pixcfg);
+
+  switch (wuffs_base__pixel_buffer__pixel_format(src).repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__Y:
+      pi.format = PNG_FORMAT_GRAY;
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      pi.format = PNG_FORMAT_BGR;
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+      pi.format = PNG_FORMAT_BGRA;
+      break;
+    default:
+      return "mimic_png_encode: unsupported pixfmt";
+  }
+
+  wuffs_base__table_u8 plane = wuffs_base__pixel_buffer__plane(src, 0);
+  if (plane.stride > INT32_MAX) {
+    return "mimic_png_encode: stride is too large";
+  }
+  png_alloc_size_t n = wuffs_base__io_buffer__writer_length(dst);
+  if (!png_image_write_to_memory(
+          &pi, wuffs_base__io_buffer__writer_pointer(dst), &n, 0, plane.ptr,
+          (png_int_32)plane.stride, NULL)) {
+    png_image_free(&pi);
+    return "mimic_png_encode: png_image_write_to_memory failed";
+  }
+  dst->meta.wi += n;
+  if (n_bytes_out) {
+    *n_bytes_out += PNG_IMAGE_SIZE(pi);
+  }
+  png_image_free(&pi);
+  return NULL;
+}
+
 #endif
 // -------------------------------- WUFFS_MIMICLIB_USE_XXX_INSTEAD_OF_LIBPNG
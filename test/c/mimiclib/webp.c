@@ -12,6 +12,7 @@
 #include <stdint.h>
 
 #include "webp/decode.h"
+#include "webp/encode.h"
 
 static void  //
 mimiclib_convert_to_y_from_bgra_nonpremul(uint8_t* dst,
@@ -114,3 +115,36 @@ mimic_webp_decode(uint64_t* n_bytes_out,
 
   return NULL;
 }
+
+const char*  //
+mimic_webp_encode(uint64_t* n_bytes_out,
+                  wuffs_base__io_buffer* dst,
+                  wuffs_base__pixel_buffer* src) {
+  if (wuffs_base__pixel_buffer__pixel_format(src).repr !=
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL) {
+    return "mimic_webp_encode: unsupported pixfmt";
+  }
+  const uint32_t w = wuffs_base__pixel_config__width(&src->pixcfg);
+  const uint32_t h = wuffs_base__pixel_config__height(&src->pixcfg);
+  wuffs_base__table_u8 plane = wuffs_base__pixel_buffer__plane(src, 0);
+  if (plane.stride > INT_MAX) {
+    return "mimic_webp_encode: stride is too large";
+  }
+
+  uint8_t* output = NULL;
+  size_t n = WebPEncodeLosslessBGRA(plane.ptr, (int)w, (int)h,
+                                    (int)plane.stride, &output);
+  if (!n) {
+    return "mimic_webp_encode: WebPEncodeLosslessBGRA failed";
+  } else if (n > wuffs_base__io_buffer__writer_length(dst)) {
+    WebPFree(output);
+    return "mimic_webp_encode: dst buffer is too small";
+  }
+  memcpy(wuffs_base__io_buffer__writer_pointer(dst), output, n);
+  WebPFree(output);
+  dst->meta.wi += n;
+  if (n_bytes_out) {
+    *n_bytes_out += 4 * w * h;
+  }
+  return NULL;
+}
@@ -147,6 +147,16 @@ golden_test g_deflate_romeo_fixed_gt = {
     .src_filename = "test/data/romeo.txt.fixed-huff.deflate",
 };
 
+// The encoder benchmarks' src files are not compressed.
+
+golden_test g_deflate_encode_midsummer_gt = {
+    .src_filename = "test/data/midsummer.txt",
+};
+
+golden_test g_deflate_encode_pi_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
 // ---------------- Deflate Tests
 
 const char*  //
@@ -728,6 +738,156 @@ test_wuffs_deflate_table_redirect() {
   return NULL;
 }
 
+const char*  //
+do_wuffs_deflate_encode(wuffs_base__io_buffer* dst,
+                        wuffs_base__io_buffer* src,
+                        uint32_t wuffs_initialize_flags,
+                        uint64_t quality,
+                        uint64_t wlimit,
+                        uint64_t rlimit) {
+  wuffs_deflate__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_deflate__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION, wuffs_initialize_flags));
+  CHECK_STATUS("set_quirk",
+               wuffs_deflate__encoder__set_quirk(
+                   &enc, WUFFS_BASE__QUIRK_QUALITY, quality));
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_deflate__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, g_work_slice_u8);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+wuffs_deflate_encode_fast(wuffs_base__io_buffer* dst,
+                          wuffs_base__io_buffer* src,
+                          uint32_t wuffs_initialize_flags,
+                          uint64_t wlimit,
+                          uint64_t rlimit) {
+  return do_wuffs_deflate_encode(
+      dst, src, wuffs_initialize_flags,
+      WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY, wlimit, rlimit);
+}
+
+const char*  //
+wuffs_deflate_encode_default(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return do_wuffs_deflate_encode(dst, src, wuffs_initialize_flags, 0, wlimit,
+                                 rlimit);
+}
+
+const char*  //
+wuffs_deflate_encode_balanced(wuffs_base__io_buffer* dst,
+                              wuffs_base__io_buffer* src,
+                              uint32_t wuffs_initialize_flags,
+                              uint64_t wlimit,
+                              uint64_t rlimit) {
+  return do_wuffs_deflate_encode(
+      dst, src, wuffs_initialize_flags,
+      WUFFS_BASE__QUIRK_QUALITY__VALUE__HIGHER_QUALITY, wlimit, rlimit);
+}
+
+// do_test_wuffs_deflate_encode_round_trip encodes the given file and then
+// checks that decoding that gives back the original bytes.
+const char*  //
+do_test_wuffs_deflate_encode_round_trip(const char* filename,
+                                        uint64_t quality,
+                                        uint64_t wlimit,
+                                        uint64_t rlimit,
+                                        uint64_t want_max_encoded_len) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+
+  CHECK_STRING(read_file(&src, filename));
+  CHECK_STRING(do_wuffs_deflate_encode(
+      &encoded, &src, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      quality, wlimit, rlimit));
+  if (src.meta.ri != src.meta.wi) {
+    RETURN_FAIL("src.meta.ri: have %zu, want %zu", src.meta.ri, src.meta.wi);
+  } else if (encoded.meta.wi > want_max_encoded_len) {
+    RETURN_FAIL("encoded length: have %zu, want <= %" PRIu64, encoded.meta.wi,
+                want_max_encoded_len);
+  }
+
+  encoded.meta.closed = true;
+  CHECK_STRING(wuffs_deflate_decode(
+      &have, &encoded, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      UINT64_MAX, UINT64_MAX));
+  return check_io_buffers_equal("", &have, &src);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_balanced() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode_round_trip(
+      "test/data/pi.txt", WUFFS_BASE__QUIRK_QUALITY__VALUE__HIGHER_QUALITY,
+      UINT64_MAX, UINT64_MAX, 47700);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_default() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode_round_trip(
+      "test/data/pi.txt", 0, UINT64_MAX, UINT64_MAX, 47800);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_empty() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode_round_trip(
+      "test/data/0.bytes", 0, UINT64_MAX, UINT64_MAX, 2);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_fast() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode_round_trip(
+      "test/data/pi.txt", WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY,
+      UINT64_MAX, UINT64_MAX, 50800);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_short_reads_writes() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_deflate_encode_round_trip(
+      "test/data/midsummer.txt",
+      WUFFS_BASE__QUIRK_QUALITY__VALUE__HIGHER_QUALITY, 7, 333, 5100);
+}
+
+const char*  //
+test_wuffs_deflate_encode_round_trip_store() {
+  CHECK_FOCUS(__func__);
+  // Storing the 11065 byte file needs 5 bytes of block header.
+  return do_test_wuffs_deflate_encode_round_trip(
+      "test/data/midsummer.txt", (uint64_t)(-2), UINT64_MAX, UINT64_MAX,
+      11070);
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -875,6 +1035,42 @@ bench_wuffs_deflate_decode_100k_many_big_reads() {
       &g_deflate_pi_gt, UINT64_MAX, 4096, 30);
 }
 
+const char*  //
+bench_wuffs_deflate_encode_10k_default() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_default,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_deflate_encode_midsummer_gt, UINT64_MAX, UINT64_MAX, 300);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_balanced() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_balanced,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_default() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_default,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+const char*  //
+bench_wuffs_deflate_encode_100k_fast() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_deflate_encode_fast,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED, tcounter_src,
+      &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -908,6 +1104,72 @@ bench_mimic_deflate_decode_100k_many_big_reads() {
                              &g_deflate_pi_gt, UINT64_MAX, 4096, 30);
 }
 
+#ifndef WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE
+
+// The mimic library's compression levels are roughly comparable to the
+// Wuffs encoder's fast, default and balanced quality settings.
+
+const char*  //
+mimic_deflate_encode_level_1(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return mimic_deflate_encode(dst, src, 1);
+}
+
+const char*  //
+mimic_deflate_encode_level_6(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return mimic_deflate_encode(dst, src, 6);
+}
+
+const char*  //
+mimic_deflate_encode_level_9(wuffs_base__io_buffer* dst,
+                             wuffs_base__io_buffer* src,
+                             uint32_t wuffs_initialize_flags,
+                             uint64_t wlimit,
+                             uint64_t rlimit) {
+  return mimic_deflate_encode(dst, src, 9);
+}
+
+const char*  //
+bench_mimic_deflate_encode_10k_default() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_level_6, 0, tcounter_src,
+                             &g_deflate_encode_midsummer_gt, UINT64_MAX,
+                             UINT64_MAX, 300);
+}
+
+const char*  //
+bench_mimic_deflate_encode_100k_balanced() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_level_9, 0, tcounter_src,
+                             &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX,
+                             30);
+}
+
+const char*  //
+bench_mimic_deflate_encode_100k_default() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_level_6, 0, tcounter_src,
+                             &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX,
+                             30);
+}
+
+const char*  //
+bench_mimic_deflate_encode_100k_fast() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_deflate_encode_level_1, 0, tcounter_src,
+                             &g_deflate_encode_pi_gt, UINT64_MAX, UINT64_MAX,
+                             30);
+}
+
+#endif  // WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -930,6 +1192,12 @@ proc g_tests[] = {
     test_wuffs_deflate_decode_romeo_fixed,
     test_wuffs_deflate_decode_split_src,
     test_wuffs_deflate_decode_truncated_input,
+    test_wuffs_deflate_encode_round_trip_balanced,
+    test_wuffs_deflate_encode_round_trip_default,
+    test_wuffs_deflate_encode_round_trip_empty,
+    test_wuffs_deflate_encode_round_trip_fast,
+    test_wuffs_deflate_encode_round_trip_short_reads_writes,
+    test_wuffs_deflate_encode_round_trip_store,
     test_wuffs_deflate_history_full,
     test_wuffs_deflate_history_partial,
     test_wuffs_deflate_table_redirect,
@@ -963,6 +1231,10 @@ proc g_benches[] = {
     bench_wuffs_deflate_decode_10k_part_init,
     bench_wuffs_deflate_decode_100k_just_one_read,
     bench_wuffs_deflate_decode_100k_many_big_reads,
+    bench_wuffs_deflate_encode_10k_default,
+    bench_wuffs_deflate_encode_100k_balanced,
+    bench_wuffs_deflate_encode_100k_default,
+    bench_wuffs_deflate_encode_100k_fast,
 
 #ifdef WUFFS_MIMIC
 
@@ -972,6 +1244,12 @@ proc g_benches[] = {
 #ifndef WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_STREAMING
     bench_mimic_deflate_decode_100k_many_big_reads,
 #endif
+#ifndef WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE
+    bench_mimic_deflate_encode_10k_default,
+    bench_mimic_deflate_encode_100k_balanced,
+    bench_mimic_deflate_encode_100k_default,
+    bench_mimic_deflate_encode_100k_fast,
+#endif
 
 #endif  // WUFFS_MIMIC
 
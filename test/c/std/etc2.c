@@ -65,6 +65,100 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 
 // ---------------- ETC2 Tests
 
+const char*  //
+wuffs_etc2_decode(uint64_t* n_bytes_out,
+                  wuffs_base__io_buffer* dst,
+                  uint32_t wuffs_initialize_flags,
+                  wuffs_base__pixel_format pixfmt,
+                  uint32_t* quirks_ptr,
+                  size_t quirks_len,
+                  wuffs_base__io_buffer* src) {
+  wuffs_etc2__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_etc2__decoder__initialize(&dec, sizeof dec, WUFFS_VERSION,
+                                               wuffs_initialize_flags));
+  return do_run__wuffs_base__image_decoder(
+      wuffs_etc2__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      n_bytes_out, dst, pixfmt, quirks_ptr, quirks_len, src);
+}
+
+// --------
+
+typedef wuffs_base__empty_struct (*etc2_from_colors_to_buffer_func)(
+    wuffs_etc2__decoder* self);
+
+// etc2_from_colors_to_buffer_implementation returns the f'th implementation,
+// where f = 0 is the portable one, or NULL if it is unavailable on this CPU.
+etc2_from_colors_to_buffer_func  //
+etc2_from_colors_to_buffer_implementation(int f, const char** name) {
+  if (f == 0) {
+    *name = "choosy_default";
+    return &wuffs_etc2__decoder__from_colors_to_buffer__choosy_default;
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+  } else if ((f == 1) && wuffs_base__cpu_arch__have_x86_avx2()) {
+    *name = "x86_avx2";
+    return &wuffs_etc2__decoder__from_colors_to_buffer_x86_avx2;
+#endif
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_etc2_decode_from_colors_to_buffer() {
+  CHECK_FOCUS(__func__);
+
+  // Pseudo-random blocks exercise every mode: individual, differential, T, H
+  // and planar, with and without punchthrough alpha.
+  const uint32_t pixfmts[2] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGRX,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY,
+  };
+  for (int p = 0; p < 2; p++) {
+    for (uint32_t seed = 1; seed <= 16; seed++) {
+      for (int f = 0; f < 2; f++) {
+        const char* func_name = NULL;
+        etc2_from_colors_to_buffer_func func =
+            etc2_from_colors_to_buffer_implementation(f, &func_name);
+        if (!func) {
+          continue;
+        }
+
+        wuffs_etc2__decoder dec;
+        CHECK_STATUS("initialize",
+                     wuffs_etc2__decoder__initialize(
+                         &dec, sizeof dec, WUFFS_VERSION,
+                         WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+        dec.private_impl.f_pixfmt = pixfmts[p];
+        dec.private_impl.f_num_buffered_blocks = 64;
+        uint64_t x = seed;
+        for (int i = 0; i < 64; i++) {
+          x = (x * 6364136223846793005u) + 1442695040888963407u;
+          dec.private_data.f_colors[1][i] = x;
+        }
+        (*func)(&dec);
+
+        // The f == 0 implementation's output is the "want" for f > 0.
+        const size_t n = sizeof dec.private_data.f_buffer;
+        uint8_t* dst_ptr = (f == 0) ? g_want_array_u8 : g_have_array_u8;
+        memcpy(dst_ptr, dec.private_data.f_buffer, n);
+        if (f == 0) {
+          continue;
+        }
+
+        wuffs_base__io_buffer have =
+            wuffs_base__ptr_u8__reader(g_have_array_u8, n, true);
+        wuffs_base__io_buffer want =
+            wuffs_base__ptr_u8__reader(g_want_array_u8, n, true);
+        char prefix[256];
+        snprintf(prefix, 256, "p=%d, seed=%" PRIu32 ", f=%d (%s): ", p, seed,
+                 f, func_name);
+        CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_etc2_decode_interface() {
   CHECK_FOCUS(__func__);
@@ -106,6 +200,119 @@ test_wuffs_etc2_decode_truncated_input() {
   return NULL;
 }
 
+const char*  //
+do_test_wuffs_etc2_decode_block_rows(const char* filename,
+                                     uint32_t band_height) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  // Decode the whole frame, as the "want".
+  wuffs_etc2__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_etc2__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_etc2__decoder__decode_image_config(&dec, &ic, &src));
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice #0", wuffs_base__pixel_buffer__set_from_slice(
+                                        &want_pb, &ic.pixcfg, g_want_slice_u8));
+  CHECK_STATUS("decode_frame", wuffs_etc2__decoder__decode_frame(
+                                   &dec, &want_pb, &src,
+                                   WUFFS_BASE__PIXEL_BLEND__SRC,
+                                   g_work_slice_u8, NULL));
+
+  // Decode each band of block rows with its own decoder, in reverse order,
+  // as if the bands were decoded concurrently.
+  wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice #1", wuffs_base__pixel_buffer__set_from_slice(
+                                        &have_pb, &ic.pixcfg, g_have_slice_u8));
+  uint32_t num_block_rows = wuffs_etc2__decoder__num_block_rows(&dec);
+  uint32_t n = (num_block_rows + band_height - 1) / band_height;
+  uint64_t end_pos =
+      wuffs_etc2__decoder__block_row_io_position(&dec, num_block_rows);
+  if (end_pos != src.meta.wi) {
+    RETURN_FAIL("end_pos: have %" PRIu64 ", want %zu", end_pos, src.meta.wi);
+  }
+  for (uint32_t b = n; b > 0; b--) {
+    uint32_t min_incl = (b - 1) * band_height;
+    uint32_t max_excl = wuffs_base__u32__min(b * band_height, num_block_rows);
+    wuffs_etc2__decoder band_dec;
+    CHECK_STATUS("initialize",
+                 wuffs_etc2__decoder__initialize(
+                     &band_dec, sizeof band_dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__io_buffer band_src = src;
+    band_src.meta.ri = 0;
+    CHECK_STATUS("decode_image_config",
+                 wuffs_etc2__decoder__decode_image_config(&band_dec, NULL,
+                                                          &band_src));
+    band_src.meta.ri = (size_t)wuffs_etc2__decoder__block_row_io_position(
+        &band_dec, min_incl);
+    wuffs_base__status status = wuffs_etc2__decoder__decode_block_rows(
+        &band_dec, &have_pb, &band_src, WUFFS_BASE__PIXEL_BLEND__SRC, min_incl,
+        max_excl);
+    if (status.repr) {
+      RETURN_FAIL("b=%" PRIu32 ": decode_block_rows: \"%s\"", b, status.repr);
+    }
+    uint64_t want_pos =
+        wuffs_etc2__decoder__block_row_io_position(&band_dec, max_excl);
+    if (band_src.meta.ri != want_pos) {
+      RETURN_FAIL("b=%" PRIu32 ": ri: have %zu, want %" PRIu64, b,
+                  band_src.meta.ri, want_pos);
+    }
+  }
+
+  // Out-of-range block rows are rejected, as is a src that isn't positioned
+  // at the first block row. Both errors disable the decoder.
+  src.meta.ri = 16;
+  wuffs_base__status status = wuffs_etc2__decoder__decode_block_rows(
+      &dec, &have_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, 0,
+      num_block_rows + 1);
+  if (status.repr != wuffs_base__error__bad_argument) {
+    RETURN_FAIL("bad range: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_argument);
+  }
+  CHECK_STATUS("initialize",
+               wuffs_etc2__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  src.meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_etc2__decoder__decode_image_config(&dec, NULL, &src));
+  status = wuffs_etc2__decoder__decode_block_rows(
+      &dec, &have_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, 1, num_block_rows);
+  if (status.repr != wuffs_base__error__bad_argument) {
+    RETURN_FAIL("bad position: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_argument);
+  }
+
+  wuffs_base__table_u8 have_tab = wuffs_base__pixel_buffer__plane(&have_pb, 0);
+  wuffs_base__table_u8 want_tab = wuffs_base__pixel_buffer__plane(&want_pb, 0);
+  size_t n_bytes = want_tab.stride * want_tab.height;
+  wuffs_base__io_buffer have =
+      wuffs_base__ptr_u8__reader(have_tab.ptr, n_bytes, true);
+  wuffs_base__io_buffer want =
+      wuffs_base__ptr_u8__reader(want_tab.ptr, n_bytes, true);
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_etc2_decode_block_rows() {
+  CHECK_FOCUS(__func__);
+  CHECK_STRING(do_test_wuffs_etc2_decode_block_rows(
+      "test/data/bricks-color.etc2.pkm", 7));
+  CHECK_STRING(do_test_wuffs_etc2_decode_block_rows(
+      "test/data/hippopotamus.masked-with-muybridge.etc2.bgra-nonpremul.pkm",
+      16));
+  CHECK_STRING(do_test_wuffs_etc2_decode_block_rows(
+      "test/data/mona-lisa.21x32.etc2.pkm", 3));
+  return NULL;
+}
+
 const char*  //
 test_wuffs_etc2_decode_frame_config() {
   CHECK_FOCUS(__func__);
@@ -142,7 +349,49 @@ test_wuffs_etc2_decode_frame_config() {
 
 // ---------------- ETC2 Benches
 
-// No ETC2 benches.
+const char*  //
+bench_wuffs_etc2_decode_image_4k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_etc2_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0,
+      "test/data/hippopotamus.masked-with-muybridge.etc2.bgra-nonpremul.pkm",
+      0, SIZE_MAX, 1000);
+}
+
+const char*  //
+bench_wuffs_etc2_decode_image_4k_32bpp_binary_alpha() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_etc2_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0,
+      "test/data/hippopotamus.masked-with-muybridge.etc2.bgra-binary.pkm", 0,
+      SIZE_MAX, 1000);
+}
+
+const char*  //
+bench_wuffs_etc2_decode_image_77k_24bpp_etc1() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_etc2_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/bricks-color.etc1.pkm", 0, SIZE_MAX, 200);
+}
+
+const char*  //
+bench_wuffs_etc2_decode_image_77k_24bpp_etc2() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_etc2_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/bricks-color.etc2.pkm", 0, SIZE_MAX, 200);
+}
 
 // ---------------- Mimic Benches
 
@@ -156,7 +405,9 @@ test_wuffs_etc2_decode_frame_config() {
 
 proc g_tests[] = {
 
+    test_wuffs_etc2_decode_block_rows,
     test_wuffs_etc2_decode_frame_config,
+    test_wuffs_etc2_decode_from_colors_to_buffer,
     test_wuffs_etc2_decode_interface,
     test_wuffs_etc2_decode_truncated_input,
 
@@ -171,7 +422,10 @@ proc g_tests[] = {
 
 proc g_benches[] = {
 
-// No ETC2 benches.
+    bench_wuffs_etc2_decode_image_4k_32bpp,
+    bench_wuffs_etc2_decode_image_4k_32bpp_binary_alpha,
+    bench_wuffs_etc2_decode_image_77k_24bpp_etc1,
+    bench_wuffs_etc2_decode_image_77k_24bpp_etc2,
 
 #ifdef WUFFS_MIMIC
 
@@ -77,6 +77,12 @@ golden_test g_gzip_pi_gt = {
     .src_filename = "test/data/pi.txt.gz",
 };
 
+// The encoder benchmarks' src files are not compressed.
+
+golden_test g_gzip_encode_pi_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
 // ---------------- Gzip Tests
 
 const char*  //
@@ -315,6 +321,62 @@ test_wuffs_gzip_decode_pi() {
                             UINT64_MAX);
 }
 
+const char*  //
+wuffs_gzip_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  wuffs_gzip__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_gzip__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION, wuffs_initialize_flags));
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_gzip__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, g_work_slice_u8);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+test_wuffs_gzip_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+
+  CHECK_STRING(read_file(&src, "test/data/pi.txt"));
+  CHECK_STRING(wuffs_gzip_encode(
+      &encoded, &src, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      1000, 777));
+  encoded.meta.closed = true;
+  CHECK_STRING(wuffs_gzip_decode(
+      &have, &encoded, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      UINT64_MAX, UINT64_MAX));
+  return check_io_buffers_equal("", &have, &src);
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -353,6 +415,14 @@ bench_wuffs_gzip_decode_100k() {
       tcounter_dst, &g_gzip_pi_gt, UINT64_MAX, UINT64_MAX, 30);
 }
 
+const char*  //
+bench_wuffs_gzip_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_gzip_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_gzip_encode_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -371,6 +441,26 @@ bench_mimic_gzip_decode_100k() {
                              UINT64_MAX, UINT64_MAX, 30);
 }
 
+#ifndef WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE
+
+const char*  //
+mimic_gzip_encode_level_6(wuffs_base__io_buffer* dst,
+                          wuffs_base__io_buffer* src,
+                          uint32_t wuffs_initialize_flags,
+                          uint64_t wlimit,
+                          uint64_t rlimit) {
+  return mimic_gzip_encode(dst, src, 6);
+}
+
+const char*  //
+bench_mimic_gzip_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_gzip_encode_level_6, 0, tcounter_src,
+                             &g_gzip_encode_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+#endif  // WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -389,6 +479,7 @@ proc g_tests[] = {
     test_wuffs_gzip_decode_midsummer,
     test_wuffs_gzip_decode_pi,
     test_wuffs_gzip_decode_truncated_input,
+    test_wuffs_gzip_encode_round_trip,
 
 #ifdef WUFFS_MIMIC
 
@@ -404,11 +495,15 @@ proc g_benches[] = {
 
     bench_wuffs_gzip_decode_10k,
     bench_wuffs_gzip_decode_100k,
+    bench_wuffs_gzip_encode_100k,
 
 #ifdef WUFFS_MIMIC
 
     bench_mimic_gzip_decode_10k,
     bench_mimic_gzip_decode_100k,
+#ifndef WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE
+    bench_mimic_gzip_encode_100k,
+#endif
 
 #endif  // WUFFS_MIMIC
 
@@ -63,6 +63,8 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 #include "../mimiclib/jpeg.c"
 #endif
 
+static wuffs_jpeg__decoder g_jpeg_delegates[3];
+
 // ---------------- JPEG Tests
 
 const char*  //
@@ -802,6 +804,196 @@ test_wuffs_jpeg_decode_mcu() {
   return NULL;
 }
 
+// decode_jpeg_via_delegates drives the delegates (as per QUIRK_DELEGATE_IDCT)
+// after dec's decode_frame call suspended with "$IDCT rows ready". Everything
+// runs on this one thread, but each delegate handles its own band of MCU
+// rows, like a multi-threaded caller would.
+const char*  //
+decode_jpeg_via_delegates(wuffs_jpeg__decoder* dec) {
+  uint32_t n = sizeof(g_jpeg_delegates) / sizeof(g_jpeg_delegates[0]);
+  uint32_t num_mcu_rows = wuffs_jpeg__decoder__num_mcu_rows(dec);
+  for (uint32_t p = 0; p < n; p++) {
+    wuffs_jpeg__decoder* d = &g_jpeg_delegates[p];
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     d, sizeof *d, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("attach_delegate",
+                 wuffs_jpeg__decoder__attach_delegate(d, g_work_slice_u8));
+  }
+
+  // Process the bands in reverse order, to check that they are independent.
+  for (uint32_t p = n; p > 0; p--) {
+    CHECK_STATUS("decode_delegated_idct",
+                 wuffs_jpeg__decoder__decode_delegated_idct(
+                     &g_jpeg_delegates[p - 1], g_work_slice_u8,
+                     (num_mcu_rows * (p - 1)) / n, (num_mcu_rows * p) / n));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_quirk_delegate_idct() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+
+  const char* filenames[5] = {
+      "test/data/bricks-gray.jpeg",           //
+      "test/data/hibiscus.primitive.jpeg",    //
+      "test/data/peacock.progressive.jpeg",   //
+      "test/data/peacock.s2x1-422.jpeg",      //
+      "test/data/peacock.s-very-weird.jpeg",  //
+  };
+  for (int i = 0; i < 5; i++) {
+    for (int q = 0; q < 2; q++) {
+      wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+          .data = g_src_slice_u8,
+      });
+      CHECK_STRING(read_file(&src, filenames[i]));
+
+      wuffs_jpeg__decoder dec;
+      CHECK_STATUS("initialize",
+                   wuffs_jpeg__decoder__initialize(
+                       &dec, sizeof dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STATUS("set_quirk", wuffs_jpeg__decoder__set_quirk(
+                                    &dec, WUFFS_JPEG__QUIRK_DELEGATE_IDCT, q));
+
+      wuffs_base__image_config ic = ((wuffs_base__image_config){});
+      CHECK_STATUS("decode_image_config",
+                   wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+      wuffs_base__pixel_config__set(
+          &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+          wuffs_base__pixel_config__width(&ic.pixcfg),
+          wuffs_base__pixel_config__height(&ic.pixcfg));
+      wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                         &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+      int num_suspensions = 0;
+      while (true) {
+        wuffs_base__status status = wuffs_jpeg__decoder__decode_frame(
+            &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8,
+            NULL);
+        if (status.repr == NULL) {
+          break;
+        } else if (status.repr != wuffs_jpeg__suspension__idct_rows_ready) {
+          RETURN_FAIL("%s, q=%d: decode_frame: \"%s\"", filenames[i], q,
+                      status.repr);
+        }
+        num_suspensions++;
+        CHECK_STRING(decode_jpeg_via_delegates(&dec));
+      }
+      if (num_suspensions != q) {
+        RETURN_FAIL("%s, q=%d: num_suspensions: have %d, want %d",
+                    filenames[i], q, num_suspensions, q);
+      }
+
+      // The final image should not depend on the quirk value.
+      wuffs_base__io_buffer* dst = q ? &have : &want;
+      dst->meta.wi = 0;
+      CHECK_STRING(copy_to_io_buffer_from_pixel_buffer(
+          dst, &pb, wuffs_base__pixel_config__bounds(&ic.pixcfg)));
+      if (q) {
+        CHECK_STRING(check_io_buffers_equal(filenames[i], &have, &want));
+      }
+    }
+  }
+
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_suspend_after_progressive_scans() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/peacock.progressive.jpeg"));
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+
+  // The peacock.progressive.jpeg file has 10 scans. Quirk value 0x0 never
+  // suspends, 0x1 suspends after the DC-only first scan and 0xFFFF_FFFF
+  // suspends after every scan.
+  const uint64_t quirk_values[3] = {0x0, 0x1, 0xFFFFFFFF};
+  const int want_num_suspensions[3] = {0, 1, 10};
+  for (int q = 0; q < 3; q++) {
+    src.meta.ri = 0;
+
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("set_quirk",
+                 wuffs_jpeg__decoder__set_quirk(
+                     &dec, WUFFS_JPEG__QUIRK_SUSPEND_AFTER_PROGRESSIVE_SCANS,
+                     quirk_values[q]));
+
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+    int num_suspensions = 0;
+    while (true) {
+      wuffs_base__status status = wuffs_jpeg__decoder__decode_frame(
+          &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8,
+          NULL);
+      if (status.repr == NULL) {
+        break;
+      } else if (status.repr !=
+                 wuffs_jpeg__suspension__progressive_scan_decoded) {
+        RETURN_FAIL("q=%d: decode_frame: \"%s\"", q, status.repr);
+      }
+      num_suspensions++;
+
+      wuffs_base__rect_ie_u32 r = wuffs_jpeg__decoder__frame_dirty_rect(&dec);
+      if (wuffs_base__rect_ie_u32__is_empty(&r)) {
+        RETURN_FAIL("q=%d: frame_dirty_rect: have empty, want non-empty", q);
+      }
+    }
+    if (num_suspensions != want_num_suspensions[q]) {
+      RETURN_FAIL("q=%d: num_suspensions: have %d, want %d", q,
+                  num_suspensions, want_num_suspensions[q]);
+    }
+
+    // The final image should not depend on the quirk value.
+    wuffs_base__io_buffer* dst = q ? &have : &want;
+    dst->meta.wi = 0;
+    CHECK_STRING(copy_to_io_buffer_from_pixel_buffer(
+        dst, &pb, wuffs_base__pixel_config__bounds(&ic.pixcfg)));
+    if (q) {
+      char prefix[64];
+      snprintf(prefix, 64, "q=%d: ", q);
+      CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+    }
+  }
+
+  return NULL;
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -906,6 +1098,16 @@ bench_wuffs_jpeg_decode_30k_24bpp_sequential() {
       NULL, 0, "test/data/peacock.default.jpeg", 0, SIZE_MAX, 50);
 }
 
+const char*  //
+bench_wuffs_jpeg_decode_30k_24bpp_422() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s2x1-422.jpeg", 0, SIZE_MAX, 50);
+}
+
 const char*  //
 bench_wuffs_jpeg_decode_77k_24bpp() {
   CHECK_FOCUS(__func__);
@@ -936,6 +1138,16 @@ bench_wuffs_jpeg_decode_552k_24bpp_444() {
       NULL, 0, "test/data/hibiscus.primitive.jpeg", 0, SIZE_MAX, 5);
 }
 
+const char*  //
+bench_wuffs_jpeg_decode_3002k_24bpp_bgr() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGR), NULL, 0,
+      "test/data/harvesters.jpeg", 0, SIZE_MAX, 1);
+}
+
 const char*  //
 bench_wuffs_jpeg_decode_4002k_24bpp() {
   CHECK_FOCUS(__func__);
@@ -980,6 +1192,16 @@ bench_mimic_jpeg_decode_30k_24bpp_sequential() {
       NULL, 0, "test/data/peacock.default.jpeg", 0, SIZE_MAX, 50);
 }
 
+const char*  //
+bench_mimic_jpeg_decode_30k_24bpp_422() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/peacock.s2x1-422.jpeg", 0, SIZE_MAX, 50);
+}
+
 const char*  //
 bench_mimic_jpeg_decode_77k_24bpp() {
   CHECK_FOCUS(__func__);
@@ -1010,6 +1232,16 @@ bench_mimic_jpeg_decode_552k_24bpp_444() {
       NULL, 0, "test/data/hibiscus.primitive.jpeg", 0, SIZE_MAX, 5);
 }
 
+const char*  //
+bench_mimic_jpeg_decode_3002k_24bpp_bgr() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &mimic_jpeg_decode,
+      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGR), NULL, 0,
+      "test/data/harvesters.jpeg", 0, SIZE_MAX, 1);
+}
+
 const char*  //
 bench_mimic_jpeg_decode_4002k_24bpp() {
   CHECK_FOCUS(__func__);
@@ -1032,6 +1264,8 @@ proc g_tests[] = {
     test_wuffs_jpeg_decode_mcu,
     test_wuffs_jpeg_decode_interface,
     test_wuffs_jpeg_decode_lower_quality,
+    test_wuffs_jpeg_decode_quirk_delegate_idct,
+    test_wuffs_jpeg_decode_suspend_after_progressive_scans,
     test_wuffs_jpeg_decode_truncated_input,
 
 #ifdef WUFFS_MIMIC
@@ -1052,9 +1286,11 @@ proc g_benches[] = {
     bench_wuffs_jpeg_decode_19k_8bpp,
     bench_wuffs_jpeg_decode_30k_24bpp_progressive,
     bench_wuffs_jpeg_decode_30k_24bpp_sequential,
+    bench_wuffs_jpeg_decode_30k_24bpp_422,
     bench_wuffs_jpeg_decode_77k_24bpp,
     bench_wuffs_jpeg_decode_552k_24bpp_420,
     bench_wuffs_jpeg_decode_552k_24bpp_444,
+    bench_wuffs_jpeg_decode_3002k_24bpp_bgr,
     bench_wuffs_jpeg_decode_4002k_24bpp,
 
 #ifdef WUFFS_MIMIC
@@ -1062,9 +1298,11 @@ proc g_benches[] = {
     bench_mimic_jpeg_decode_19k_8bpp,
     bench_mimic_jpeg_decode_30k_24bpp_progressive,
     bench_mimic_jpeg_decode_30k_24bpp_sequential,
+    bench_mimic_jpeg_decode_30k_24bpp_422,
     bench_mimic_jpeg_decode_77k_24bpp,
     bench_mimic_jpeg_decode_552k_24bpp_420,
     bench_mimic_jpeg_decode_552k_24bpp_444,
+    bench_mimic_jpeg_decode_3002k_24bpp_bgr,
     bench_mimic_jpeg_decode_4002k_24bpp,
 
 #endif  // WUFFS_MIMIC
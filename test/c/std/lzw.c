@@ -107,6 +107,7 @@ test_wuffs_lzw_decode_truncated_input() {
 const char*  //
 do_test_wuffs_lzw_decode(const char* src_filename,
                          uint64_t src_size,
+                         uint8_t want_literal_width,
                          const char* want_filename,
                          uint64_t want_size,
                          uint64_t wlimit,
@@ -126,11 +127,11 @@ do_test_wuffs_lzw_decode(const char* src_filename,
     RETURN_FAIL("src size: have %d, want %d", (int)(src.meta.wi),
                 (int)(src_size));
   }
-  // The first byte in that file, the LZW literal width, should be 0x08.
+  // The first byte in that file is the LZW literal width.
   uint8_t literal_width = src.data.ptr[0];
-  if (literal_width != 0x08) {
+  if (literal_width != want_literal_width) {
     RETURN_FAIL("LZW literal width: have %d, want %d", (int)(src.data.ptr[0]),
-                0x08);
+                (int)(want_literal_width));
   }
   src.meta.ri++;
 
@@ -200,7 +201,7 @@ const char*  //
 test_wuffs_lzw_decode_bricks_dither() {
   CHECK_FOCUS(__func__);
   return do_test_wuffs_lzw_decode("test/data/bricks-dither.indexes.giflzw",
-                                  14923, "test/data/bricks-dither.indexes",
+                                  14923, 8, "test/data/bricks-dither.indexes",
                                   19200, UINT64_MAX, UINT64_MAX);
 }
 
@@ -208,7 +209,7 @@ const char*  //
 test_wuffs_lzw_decode_bricks_nodither() {
   CHECK_FOCUS(__func__);
   return do_test_wuffs_lzw_decode("test/data/bricks-nodither.indexes.giflzw",
-                                  13382, "test/data/bricks-nodither.indexes",
+                                  13382, 8, "test/data/bricks-nodither.indexes",
                                   19200, UINT64_MAX, UINT64_MAX);
 }
 
@@ -216,7 +217,7 @@ const char*  //
 test_wuffs_lzw_decode_many_big_reads() {
   CHECK_FOCUS(__func__);
   return do_test_wuffs_lzw_decode("test/data/bricks-gray.indexes.giflzw", 14731,
-                                  "test/data/bricks-gray.indexes", 19200,
+                                  8, "test/data/bricks-gray.indexes", 19200,
                                   UINT64_MAX, 4096);
 }
 
@@ -224,18 +225,29 @@ const char*  //
 test_wuffs_lzw_decode_many_small_writes_reads() {
   CHECK_FOCUS(__func__);
   return do_test_wuffs_lzw_decode("test/data/bricks-gray.indexes.giflzw", 14731,
-                                  "test/data/bricks-gray.indexes", 19200, 41,
+                                  8, "test/data/bricks-gray.indexes", 19200, 41,
                                   43);
 }
 
 const char*  //
 test_wuffs_lzw_decode_pi() {
   CHECK_FOCUS(__func__);
-  return do_test_wuffs_lzw_decode("test/data/pi.txt.giflzw", 50550,
+  return do_test_wuffs_lzw_decode("test/data/pi.txt.giflzw", 50550, 8,
                                   "test/data/pi.txt", 100003, UINT64_MAX,
                                   UINT64_MAX);
 }
 
+const char*  //
+test_wuffs_lzw_decode_long_emissions() {
+  CHECK_FOCUS(__func__);
+  // Over half of this screen recording's emissions are more than 64 bytes
+  // long, and many repeat an emission from earlier in the output.
+  return do_test_wuffs_lzw_decode(
+      "test/data/gifplayer-muybridge-frame-000.indexes.giflzw", 1412, 6,
+      "test/data/gifplayer-muybridge-frame-000.indexes", 140656, 1000,
+      UINT64_MAX);
+}
+
 const char*  //
 test_wuffs_lzw_decode_output_bad() {
   CHECK_FOCUS(__func__);
@@ -425,9 +437,9 @@ do_bench_wuffs_lzw_decode(const char* filename, uint64_t iters_unscaled) {
     RETURN_FAIL("src size: have %d, want > 0", (int)(src.meta.wi));
   }
   uint8_t literal_width = src.data.ptr[0];
-  if (literal_width != 0x08) {
-    RETURN_FAIL("LZW literal width: have %d, want %d", (int)(src.data.ptr[0]),
-                0x08);
+  if (literal_width > 0x08) {
+    RETURN_FAIL("LZW literal width: have %d, want <= %d",
+                (int)(src.data.ptr[0]), 0x08);
   }
 
   bench_start();
@@ -441,6 +453,8 @@ do_bench_wuffs_lzw_decode(const char* filename, uint64_t iters_unscaled) {
                  wuffs_lzw__decoder__initialize(
                      &dec, sizeof dec, WUFFS_VERSION,
                      WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_lzw__decoder__set_quirk(
+        &dec, WUFFS_LZW__QUIRK_LITERAL_WIDTH_PLUS_ONE, literal_width + 1);
     CHECK_STATUS("transform_io", wuffs_lzw__decoder__transform_io(
                                      &dec, &have, &src, g_work_slice_u8));
     n_bytes += have.meta.wi;
@@ -461,6 +475,13 @@ bench_wuffs_lzw_decode_100k() {
   return do_bench_wuffs_lzw_decode("test/data/pi.txt.giflzw", 10);
 }
 
+const char*  //
+bench_wuffs_lzw_decode_140k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_lzw_decode(
+      "test/data/gifplayer-muybridge-frame-000.indexes.giflzw", 10);
+}
+
 // ---------------- Manifest
 
 proc g_tests[] = {
@@ -468,6 +489,7 @@ proc g_tests[] = {
     test_wuffs_lzw_decode_bricks_dither,
     test_wuffs_lzw_decode_bricks_nodither,
     test_wuffs_lzw_decode_interface,
+    test_wuffs_lzw_decode_long_emissions,
     test_wuffs_lzw_decode_many_big_reads,
     test_wuffs_lzw_decode_many_small_writes_reads,
     test_wuffs_lzw_decode_output_bad,
@@ -484,6 +506,7 @@ proc g_benches[] = {
 
     bench_wuffs_lzw_decode_20k,
     bench_wuffs_lzw_decode_100k,
+    bench_wuffs_lzw_decode_140k,
 
     NULL,
 };
@@ -973,6 +973,467 @@ test_wuffs_png_decode_restart_frame() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_png_decode_restart_frame_animated() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/animated-red-blue.apng"));
+
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+  // Decode every frame, remembering their io_positions and, since fdAT chunks
+  // also consume sequence numbers, their fcTL chunks' sequence numbers.
+  uint64_t io_positions[4] = {0};
+  uint32_t seq_nums[4] = {0};
+  for (int i = 0; i < 4; i++) {
+    seq_nums[i] = wuffs_png__decoder__next_animation_sequence_number(&dec);
+    wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+    CHECK_STATUS("decode_frame_config",
+                 wuffs_png__decoder__decode_frame_config(&dec, &fc, &src));
+    io_positions[i] = wuffs_base__frame_config__io_position(&fc);
+    CHECK_STATUS("decode_frame",
+                 wuffs_png__decoder__decode_frame(
+                     &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                     g_work_slice_u8, NULL));
+  }
+
+  // Restarting from frame 0 resets the expected sequence number. Restarting
+  // from a later frame needs the caller to supply it.
+  for (int r = 3; r >= 0; r--) {
+    CHECK_STATUS("restart_frame", wuffs_png__decoder__restart_frame(
+                                      &dec, r, io_positions[r]));
+    if (r > 0) {
+      CHECK_STATUS("set_next_animation_sequence_number",
+                   wuffs_png__decoder__set_next_animation_sequence_number(
+                       &dec, seq_nums[r]));
+    }
+    src.meta.ri = io_positions[r];
+    for (int i = r; i < 4; i++) {
+      wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+      CHECK_STATUS("decode_frame_config",
+                   wuffs_png__decoder__decode_frame_config(&dec, &fc, &src));
+      uint64_t have = wuffs_base__frame_config__index(&fc);
+      if (have != (uint64_t)i) {
+        RETURN_FAIL("r=%d: index: have %" PRIu64 ", want %d", r, have, i);
+      }
+      CHECK_STATUS("decode_frame",
+                   wuffs_png__decoder__decode_frame(
+                       &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                       g_work_slice_u8, NULL));
+    }
+  }
+
+  // Otherwise, the sequence numbers are still checked.
+  CHECK_STATUS("restart_frame",
+               wuffs_png__decoder__restart_frame(&dec, 2, io_positions[2]));
+  src.meta.ri = io_positions[2];
+  wuffs_base__status status =
+      wuffs_png__decoder__decode_frame_config(&dec, NULL, &src);
+  if (status.repr != wuffs_png__error__bad_animation_sequence_number) {
+    RETURN_FAIL("decode_frame_config: have \"%s\", want \"%s\"", status.repr,
+                wuffs_png__error__bad_animation_sequence_number);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_seek_past_pixel_data() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/hippopotamus.regular.png"));
+
+  // "hd test/data/hippopotamus.regular.png" says that the IDAT chunk starts at
+  // 0x0021 and the IEND chunk starts at 0x0853. Only make the first 0x0100
+  // bytes available, as if reading from a file in 0x0100 byte increments.
+  size_t full_wi = src.meta.wi;
+  src.meta.wi = 0x0100;
+  src.meta.closed = false;
+
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("set_quirk",
+               wuffs_png__decoder__set_quirk(
+                   &dec, WUFFS_BASE__QUIRK_SEEK_PAST_PIXEL_DATA, 1));
+
+  CHECK_STATUS("decode_frame_config #0",
+               wuffs_png__decoder__decode_frame_config(&dec, NULL, &src));
+
+  wuffs_base__status status =
+      wuffs_png__decoder__decode_frame_config(&dec, NULL, &src);
+  if (status.repr != wuffs_base__note__i_o_seek) {
+    RETURN_FAIL("decode_frame_config #1: have \"%s\", want \"%s\"",
+                status.repr, wuffs_base__note__i_o_seek);
+  }
+
+  wuffs_base__io_buffer empty = wuffs_base__empty_io_buffer();
+  wuffs_base__more_information minfo = wuffs_base__empty_more_information();
+  CHECK_STATUS("tell_me_more",
+               wuffs_png__decoder__tell_me_more(&dec, &empty, &minfo, &src));
+  if (minfo.flavor != WUFFS_BASE__MORE_INFORMATION__FLAVOR__IO_SEEK) {
+    RETURN_FAIL("flavor: have %" PRIu32 ", want %" PRIu32, minfo.flavor,
+                (uint32_t)WUFFS_BASE__MORE_INFORMATION__FLAVOR__IO_SEEK);
+  }
+  uint64_t have = wuffs_base__more_information__io_seek__position(&minfo);
+  if (have != 0x0853) {
+    RETURN_FAIL("position: have 0x%" PRIX64 ", want 0x0853", have);
+  }
+
+  src.meta.wi = full_wi;
+  src.meta.ri = 0x0853;
+  src.meta.closed = true;
+  status = wuffs_png__decoder__decode_frame_config(&dec, NULL, &src);
+  if (status.repr != wuffs_base__note__end_of_data) {
+    RETURN_FAIL("decode_frame_config #2: have \"%s\", want \"%s\"",
+                status.repr, wuffs_base__note__end_of_data);
+  }
+  return NULL;
+}
+
+const char*  //
+do_wuffs_png_decode_to_pixel_buffer(wuffs_base__pixel_buffer* pb,
+                                    wuffs_base__slice_u8 pixbuf,
+                                    uint32_t pixfmt_repr,
+                                    wuffs_base__io_buffer* src) {
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, src));
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, pixfmt_repr, WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+      wuffs_base__pixel_config__width(&ic.pixcfg),
+      wuffs_base__pixel_config__height(&ic.pixcfg));
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     pb, &ic.pixcfg, pixbuf));
+  CHECK_STATUS("decode_frame",
+               wuffs_png__decoder__decode_frame(
+                   &dec, pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   g_work_slice_u8, NULL));
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_stored_blocks() {
+  CHECK_FOCUS(__func__);
+
+  // hippopotamus.stored.png has the same pixels as hippopotamus.regular.png
+  // but its zlib-compressed data consists only of stored (uncompressed)
+  // deflate blocks, spread over multiple IDAT chunks. Every third row is
+  // unfiltered, so that some rows are passed through directly from the
+  // source and others are not.
+  wuffs_base__io_buffer want_src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&want_src, "test/data/hippopotamus.regular.png"));
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_png_decode_to_pixel_buffer(
+      &want_pb, g_want_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      &want_src));
+
+  wuffs_base__io_buffer have_src = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  CHECK_STRING(read_file(&have_src, "test/data/hippopotamus.stored.png"));
+  wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_png_decode_to_pixel_buffer(
+      &have_pb, g_pixel_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      &have_src));
+
+  uint64_t n = wuffs_base__pixel_config__pixbuf_len(&want_pb.pixcfg);
+  wuffs_base__io_buffer have = wuffs_base__ptr_u8__reader(
+      wuffs_base__pixel_buffer__plane(&have_pb, 0).ptr, n, true);
+  wuffs_base__io_buffer want = wuffs_base__ptr_u8__reader(
+      wuffs_base__pixel_buffer__plane(&want_pb, 0).ptr, n, true);
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+do_test_wuffs_png_decode_strips(const char* filename,
+                                uint32_t want_num_strips,
+                                wuffs_base__pixel_buffer* want_pb) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  // Decoding the whole frame ignores any iDOT chunk.
+  wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_png_decode_to_pixel_buffer(
+      &have_pb, g_have_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      &src));
+  uint64_t n = wuffs_base__pixel_config__pixbuf_len(&want_pb->pixcfg);
+  wuffs_base__io_buffer have = wuffs_base__ptr_u8__reader(
+      wuffs_base__pixel_buffer__plane(&have_pb, 0).ptr, n, true);
+  wuffs_base__io_buffer want = wuffs_base__ptr_u8__reader(
+      wuffs_base__pixel_buffer__plane(want_pb, 0).ptr, n, true);
+  CHECK_STRING(check_io_buffers_equal("decode_frame ", &have, &want));
+
+  // Decode each strip with its own decoder, in reverse order, as if the
+  // strips were decoded concurrently, sharing one work buffer.
+  memset(g_have_array_u8, 0, n);
+  wuffs_png__decoder dec;
+  uint32_t num_strips = 0;
+  size_t final_ri = 0;
+  for (uint32_t s = want_num_strips; s > 0; s--) {
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    src.meta.ri = 0;
+    CHECK_STATUS("decode_image_config",
+                 wuffs_png__decoder__decode_image_config(&dec, NULL, &src));
+    num_strips = wuffs_png__decoder__num_strips(&dec);
+    if (num_strips != want_num_strips) {
+      RETURN_FAIL("num_strips: have %" PRIu32 ", want %" PRIu32, num_strips,
+                  want_num_strips);
+    }
+    wuffs_base__range_ie_u64 r =
+        wuffs_png__decoder__strip_workbuf_range(&dec, s - 1);
+    if (r.max_excl > g_work_slice_u8.len) {
+      RETURN_FAIL("s=%" PRIu32 ": strip_workbuf_range is too long", s);
+    }
+    wuffs_base__slice_u8 workbuf = wuffs_base__make_slice_u8(
+        g_work_slice_u8.ptr + r.min_incl, r.max_excl - r.min_incl);
+    src.meta.ri = (size_t)wuffs_png__decoder__strip_io_position(&dec, s - 1);
+    wuffs_base__status status = wuffs_png__decoder__decode_strip(
+        &dec, &have_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, workbuf, s - 1);
+    if (status.repr) {
+      RETURN_FAIL("s=%" PRIu32 ": decode_strip: \"%s\"", s, status.repr);
+    } else if (s == want_num_strips) {
+      final_ri = src.meta.ri;
+    }
+  }
+  uint32_t height = wuffs_base__pixel_config__height(&want_pb->pixcfg);
+  if (wuffs_png__decoder__strip_row(&dec, num_strips) != height) {
+    RETURN_FAIL("strip_row(num_strips): have %" PRIu32 ", want %" PRIu32,
+                wuffs_png__decoder__strip_row(&dec, num_strips), height);
+  }
+
+  // After finish_strips, and resuming where the last strip left off, the next
+  // frame config is the IEND chunk's "@end of data".
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  src.meta.ri = 0;
+  CHECK_STATUS("decode_frame_config #0",
+               wuffs_png__decoder__decode_frame_config(&dec, NULL, &src));
+  CHECK_STATUS("finish_strips", wuffs_png__decoder__finish_strips(&dec));
+  src.meta.ri = final_ri;
+  wuffs_base__status status =
+      wuffs_png__decoder__decode_frame_config(&dec, NULL, &src);
+  if (status.repr != wuffs_base__note__end_of_data) {
+    RETURN_FAIL("decode_frame_config #1: have \"%s\", want \"%s\"",
+                status.repr, wuffs_base__note__end_of_data);
+  } else if (wuffs_png__decoder__num_decoded_frames(&dec) != 1) {
+    RETURN_FAIL("num_decoded_frames: have %" PRIu64 ", want 1",
+                wuffs_png__decoder__num_decoded_frames(&dec));
+  }
+
+  // An out-of-range strip is rejected, as is a src that isn't positioned at
+  // the strip's first IDAT chunk.
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  src.meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, NULL, &src));
+  status = wuffs_png__decoder__decode_strip(
+      &dec, &have_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8,
+      num_strips);
+  if (status.repr != wuffs_base__error__bad_argument) {
+    RETURN_FAIL("bad strip: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_argument);
+  }
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  src.meta.ri = 0;
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, NULL, &src));
+  src.meta.ri++;
+  status = wuffs_png__decoder__decode_strip(
+      &dec, &have_pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8, 0);
+  if (status.repr != wuffs_base__error__bad_argument) {
+    RETURN_FAIL("bad position: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_argument);
+  }
+
+  have = wuffs_base__ptr_u8__reader(
+      wuffs_base__pixel_buffer__plane(&have_pb, 0).ptr, n, true);
+  return check_io_buffers_equal("decode_strip ", &have, &want);
+}
+
+const char*  //
+test_wuffs_png_decode_strips() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer want_src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&want_src, "test/data/hippopotamus.regular.png"));
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_png_decode_to_pixel_buffer(
+      &want_pb, g_want_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      &want_src));
+
+  // hippopotamus.idot.png has the same pixels as hippopotamus.regular.png
+  // but an iDOT chunk splits its rows (and zlib data) into two strips.
+  CHECK_STRING(do_test_wuffs_png_decode_strips(
+      "test/data/hippopotamus.idot.png", 2, &want_pb));
+  CHECK_STRING(do_test_wuffs_png_decode_strips(
+      "test/data/hippopotamus.regular.png", 1, &want_pb));
+  return NULL;
+}
+
+const char*  //
+do_wuffs_png_encode(wuffs_base__io_buffer* dst,
+                    wuffs_base__pixel_buffer* src,
+                    uint64_t dst_limit,
+                    uint64_t quality) {
+  wuffs_png__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_png__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("set_quirk", wuffs_png__encoder__set_quirk(
+                                &enc, WUFFS_BASE__QUIRK_QUALITY, quality));
+
+  uint64_t workbuf_len =
+      wuffs_png__encoder__workbuf_len(
+          &enc, wuffs_base__pixel_config__width(&src->pixcfg),
+          wuffs_base__pixel_config__height(&src->pixcfg),
+          wuffs_base__pixel_buffer__pixel_format(src))
+          .min_incl;
+  if (workbuf_len > g_work_slice_u8.len) {
+    RETURN_FAIL("workbuf_len: have %" PRIu64 ", want <= %zu", workbuf_len,
+                g_work_slice_u8.len);
+  }
+  wuffs_base__slice_u8 workbuf =
+      wuffs_base__make_slice_u8(g_work_slice_u8.ptr, workbuf_len);
+
+  const size_t capacity = dst->data.len;
+  while (true) {
+    dst->data.len = capacity;
+    if ((capacity - dst->meta.wi) > dst_limit) {
+      dst->data.len = dst->meta.wi + dst_limit;
+    }
+    wuffs_base__status status =
+        wuffs_png__encoder__encode_image(&enc, dst, src, workbuf);
+    dst->data.len = capacity;
+    if (wuffs_base__status__is_ok(&status)) {
+      break;
+    } else if (status.repr != wuffs_base__suspension__short_write) {
+      RETURN_FAIL("encode_image: %s", status.repr);
+    } else if (dst->meta.wi >= capacity) {
+      RETURN_FAIL("encode_image: dst buffer is too small");
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+do_test_wuffs_png_encode_round_trip(const char* filename,
+                                    uint32_t pixfmt_repr,
+                                    uint64_t dst_limit,
+                                    uint64_t quality,
+                                    uint64_t want_max_encoded_len) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_png_decode_to_pixel_buffer(&want_pb, g_want_slice_u8,
+                                                   pixfmt_repr, &src));
+
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  CHECK_STRING(do_wuffs_png_encode(&encoded, &want_pb, dst_limit, quality));
+  if (encoded.meta.wi > want_max_encoded_len) {
+    RETURN_FAIL("encoded length: have %zu, want <= %" PRIu64, encoded.meta.wi,
+                want_max_encoded_len);
+  }
+  encoded.meta.closed = true;
+
+  wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_png_decode_to_pixel_buffer(&have_pb, g_pixel_slice_u8,
+                                                   pixfmt_repr, &encoded));
+
+  uint64_t n = wuffs_base__pixel_config__pixbuf_len(&want_pb.pixcfg);
+  wuffs_base__io_buffer have = wuffs_base__ptr_u8__reader(
+      wuffs_base__pixel_buffer__plane(&have_pb, 0).ptr, n, true);
+  wuffs_base__io_buffer want = wuffs_base__ptr_u8__reader(
+      wuffs_base__pixel_buffer__plane(&want_pb, 0).ptr, n, true);
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_png_encode_round_trip_y() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_png_encode_round_trip(
+      "test/data/bricks-gray.png", WUFFS_BASE__PIXEL_FORMAT__Y, UINT64_MAX, 0,
+      16000);
+}
+
+const char*  //
+test_wuffs_png_encode_round_trip_bgr() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_png_encode_round_trip(
+      "test/data/hat.png", WUFFS_BASE__PIXEL_FORMAT__BGR, UINT64_MAX, 0,
+      60000);
+}
+
+const char*  //
+test_wuffs_png_encode_round_trip_bgra_nonpremul() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_png_encode_round_trip(
+      "test/data/hibiscus.primitive.png",
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, UINT64_MAX, 0, 1000000);
+}
+
+const char*  //
+test_wuffs_png_encode_round_trip_higher_quality() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_png_encode_round_trip(
+      "test/data/hibiscus.primitive.png",
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, UINT64_MAX,
+      WUFFS_BASE__QUIRK_QUALITY__VALUE__HIGHER_QUALITY, 50000);
+}
+
+const char*  //
+test_wuffs_png_encode_round_trip_short_writes() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_png_encode_round_trip(
+      "test/data/pjw-thumbnail.png", WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      7, 0, 1000);
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -1062,6 +1523,48 @@ test_mimic_png_decode_bad_crc32_checksum_critical() {
 
 // ---------------- PNG Benches
 
+const char*  //
+wuffs_png_encode(uint64_t* n_bytes_out,
+                 wuffs_base__io_buffer* dst,
+                 wuffs_base__pixel_buffer* src) {
+  CHECK_STRING(do_wuffs_png_encode(dst, src, UINT64_MAX, 0));
+  if (n_bytes_out) {
+    *n_bytes_out += wuffs_base__pixel_config__pixbuf_len(&src->pixcfg);
+  }
+  return NULL;
+}
+
+const char*  //
+do_bench_png_encode(const char* (*encode_func)(uint64_t* n_bytes_out,
+                                               wuffs_base__io_buffer* dst,
+                                               wuffs_base__pixel_buffer* src),
+                    const char* filename,
+                    uint32_t pixfmt_repr,
+                    uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_png_decode_to_pixel_buffer(&pb, g_pixel_slice_u8,
+                                                   pixfmt_repr, &src));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    wuffs_base__io_buffer dst = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    CHECK_STRING((*encode_func)(&n_bytes, &dst, &pb));
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+// --------
+
 const char*  //
 bench_wuffs_png_decode_image_19k_8bpp() {
   CHECK_FOCUS(__func__);
@@ -1178,6 +1681,7 @@ do_bench_wuffs_png_decode_filter(uint8_t filter,
   uint64_t n_bytes = 0;
   uint64_t iters = iters_unscaled * g_flags.iterscale;
   for (uint64_t i = 0; i < iters; i++) {
+    dec.private_impl.f_pass_num_swizzled_rows = 0;
     CHECK_STATUS(
         "filter_and_swizzle",
         wuffs_png__decoder__filter_and_swizzle(
@@ -1200,6 +1704,18 @@ bench_wuffs_png_decode_filt_1_dist_4() {
   return do_bench_wuffs_png_decode_filter(1, 4, 200);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_1_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(1, 6, 200);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_1_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(1, 8, 200);
+}
+
 const char*  //
 bench_wuffs_png_decode_filt_2_dist_3() {
   CHECK_FOCUS(__func__);
@@ -1212,6 +1728,18 @@ bench_wuffs_png_decode_filt_2_dist_4() {
   return do_bench_wuffs_png_decode_filter(2, 4, 1000);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_2_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(2, 6, 1000);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_2_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(2, 8, 1000);
+}
+
 const char*  //
 bench_wuffs_png_decode_filt_3_dist_3() {
   CHECK_FOCUS(__func__);
@@ -1224,6 +1752,18 @@ bench_wuffs_png_decode_filt_3_dist_4() {
   return do_bench_wuffs_png_decode_filter(3, 4, 100);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_3_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(3, 6, 100);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_3_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(3, 8, 100);
+}
+
 const char*  //
 bench_wuffs_png_decode_filt_4_dist_3() {
   CHECK_FOCUS(__func__);
@@ -1236,6 +1776,48 @@ bench_wuffs_png_decode_filt_4_dist_4() {
   return do_bench_wuffs_png_decode_filter(4, 4, 20);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_4_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(4, 6, 20);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_4_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(4, 8, 20);
+}
+
+const char*  //
+bench_wuffs_png_encode_image_19k_8bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_png_encode(&wuffs_png_encode,
+                             "test/data/bricks-gray.no-ancillary.png",
+                             WUFFS_BASE__PIXEL_FORMAT__Y, 50);
+}
+
+const char*  //
+bench_wuffs_png_encode_image_40k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_png_encode(&wuffs_png_encode, "test/data/hat.png",
+                             WUFFS_BASE__PIXEL_FORMAT__BGR, 30);
+}
+
+const char*  //
+bench_wuffs_png_encode_image_552k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_png_encode(&wuffs_png_encode,
+                             "test/data/hibiscus.primitive.png",
+                             WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 4);
+}
+
+const char*  //
+bench_wuffs_png_encode_image_4002k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_png_encode(&wuffs_png_encode, "test/data/harvesters.png",
+                             WUFFS_BASE__PIXEL_FORMAT__BGR, 1);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -1295,6 +1877,40 @@ bench_mimic_png_decode_image_4002k_24bpp() {
       NULL, 0, "test/data/harvesters.png", 0, SIZE_MAX, 1);
 }
 
+#ifndef WUFFS_MIMICLIB_PNG_DOES_NOT_SUPPORT_ENCODE
+
+const char*  //
+bench_mimic_png_encode_image_19k_8bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_png_encode(&mimic_png_encode,
+                             "test/data/bricks-gray.no-ancillary.png",
+                             WUFFS_BASE__PIXEL_FORMAT__Y, 50);
+}
+
+const char*  //
+bench_mimic_png_encode_image_40k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_png_encode(&mimic_png_encode, "test/data/hat.png",
+                             WUFFS_BASE__PIXEL_FORMAT__BGR, 30);
+}
+
+const char*  //
+bench_mimic_png_encode_image_552k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_png_encode(&mimic_png_encode,
+                             "test/data/hibiscus.primitive.png",
+                             WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 4);
+}
+
+const char*  //
+bench_mimic_png_encode_image_4002k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_png_encode(&mimic_png_encode, "test/data/harvesters.png",
+                             WUFFS_BASE__PIXEL_FORMAT__BGR, 1);
+}
+
+#endif  // WUFFS_MIMICLIB_PNG_DOES_NOT_SUPPORT_ENCODE
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -1312,7 +1928,16 @@ proc g_tests[] = {
     test_wuffs_png_decode_metadata_kvp,
     test_wuffs_png_decode_multiple_idats,
     test_wuffs_png_decode_restart_frame,
+    test_wuffs_png_decode_restart_frame_animated,
+    test_wuffs_png_decode_seek_past_pixel_data,
+    test_wuffs_png_decode_stored_blocks,
+    test_wuffs_png_decode_strips,
     test_wuffs_png_decode_truncated_input,
+    test_wuffs_png_encode_round_trip_bgr,
+    test_wuffs_png_encode_round_trip_bgra_nonpremul,
+    test_wuffs_png_encode_round_trip_higher_quality,
+    test_wuffs_png_encode_round_trip_short_writes,
+    test_wuffs_png_encode_round_trip_y,
 
 #ifdef WUFFS_MIMIC
 
@@ -1335,18 +1960,30 @@ proc g_benches[] = {
 
     bench_wuffs_png_decode_filt_1_dist_3,
     bench_wuffs_png_decode_filt_1_dist_4,
+    bench_wuffs_png_decode_filt_1_dist_6,
+    bench_wuffs_png_decode_filt_1_dist_8,
     bench_wuffs_png_decode_filt_2_dist_3,
     bench_wuffs_png_decode_filt_2_dist_4,
+    bench_wuffs_png_decode_filt_2_dist_6,
+    bench_wuffs_png_decode_filt_2_dist_8,
     bench_wuffs_png_decode_filt_3_dist_3,
     bench_wuffs_png_decode_filt_3_dist_4,
+    bench_wuffs_png_decode_filt_3_dist_6,
+    bench_wuffs_png_decode_filt_3_dist_8,
     bench_wuffs_png_decode_filt_4_dist_3,
     bench_wuffs_png_decode_filt_4_dist_4,
+    bench_wuffs_png_decode_filt_4_dist_6,
+    bench_wuffs_png_decode_filt_4_dist_8,
     bench_wuffs_png_decode_image_19k_8bpp,
     bench_wuffs_png_decode_image_40k_24bpp,
     bench_wuffs_png_decode_image_77k_8bpp,
     bench_wuffs_png_decode_image_552k_32bpp_ignore_checksum,
     bench_wuffs_png_decode_image_552k_32bpp_verify_checksum,
     bench_wuffs_png_decode_image_4002k_24bpp,
+    bench_wuffs_png_encode_image_19k_8bpp,
+    bench_wuffs_png_encode_image_40k_24bpp,
+    bench_wuffs_png_encode_image_552k_32bpp,
+    bench_wuffs_png_encode_image_4002k_24bpp,
 
 #ifdef WUFFS_MIMIC
 
@@ -1360,6 +1997,12 @@ proc g_benches[] = {
     bench_mimic_png_decode_image_552k_32bpp_verify_checksum,
 #endif
     bench_mimic_png_decode_image_4002k_24bpp,
+#ifndef WUFFS_MIMICLIB_PNG_DOES_NOT_SUPPORT_ENCODE
+    bench_mimic_png_encode_image_19k_8bpp,
+    bench_mimic_png_encode_image_40k_24bpp,
+    bench_mimic_png_encode_image_552k_32bpp,
+    bench_mimic_png_encode_image_4002k_24bpp,
+#endif
 
 #endif  // WUFFS_MIMIC
 
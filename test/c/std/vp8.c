@@ -65,6 +65,90 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 
 // ---------------- VP8 Tests
 
+typedef wuffs_base__empty_struct (*vp8_filter_func)(wuffs_vp8__decoder*,
+                                                    wuffs_base__slice_u8,
+                                                    uint32_t);
+typedef wuffs_base__empty_struct (*vp8_filter_inter_block_func)(
+    wuffs_vp8__decoder*,
+    uint32_t,
+    uint32_t,
+    uint32_t,
+    uint32_t,
+    uint32_t,
+    uint32_t);
+typedef wuffs_base__empty_struct (*vp8_inverse_dct_full_func)(
+    wuffs_vp8__decoder*,
+    uint32_t,
+    uint32_t,
+    uint32_t);
+typedef wuffs_base__empty_struct (*vp8_predict_uv8_func)(wuffs_vp8__decoder*,
+                                                         uint32_t,
+                                                         uint32_t);
+typedef wuffs_base__empty_struct (*vp8_predict_y16_func)(wuffs_vp8__decoder*,
+                                                         uint32_t);
+typedef wuffs_base__empty_struct (*vp8_predict_y4_func)(wuffs_vp8__decoder*,
+                                                        uint32_t);
+
+// vp8_implementation holds one implementation (e.g. "choosy_default" or
+// "x86_sse42") of each of the VP8 decoder's SIMD-accelerated methods.
+typedef struct {
+  const char* name;
+  vp8_filter_inter_block_func filter_inter_block;
+  vp8_filter_func filter_normal;
+  vp8_filter_func filter_simple;
+  vp8_inverse_dct_full_func inverse_dct_full;
+  vp8_predict_uv8_func predict_uv8;
+  vp8_predict_y16_func predict_y16;
+  vp8_predict_y4_func predict_y4;
+} vp8_implementation;
+
+#define VP8_NUM_IMPLEMENTATIONS 2
+
+// vp8_get_implementation sets *impl to the f'th implementation, where f = 0
+// is the portable one, and returns whether that implementation is available
+// on this CPU.
+bool  //
+vp8_get_implementation(int f, vp8_implementation* impl) {
+  if (f == 0) {
+    impl->name = "choosy_default";
+    impl->filter_inter_block =
+        &wuffs_vp8__decoder__filter_inter_block__choosy_default;
+    impl->filter_normal = &wuffs_vp8__decoder__filter_normal__choosy_default;
+    impl->filter_simple = &wuffs_vp8__decoder__filter_simple__choosy_default;
+    impl->inverse_dct_full =
+        &wuffs_vp8__decoder__inverse_dct_full__choosy_default;
+    impl->predict_uv8 = &wuffs_vp8__decoder__predict_uv8__choosy_default;
+    impl->predict_y16 = &wuffs_vp8__decoder__predict_y16__choosy_default;
+    impl->predict_y4 = &wuffs_vp8__decoder__predict_y4__choosy_default;
+    return true;
+  }
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V2)
+  if ((f == 1) && wuffs_base__cpu_arch__have_x86_sse42()) {
+    impl->name = "x86_sse42";
+    impl->filter_inter_block =
+        &wuffs_vp8__decoder__filter_inter_block_x86_sse42;
+    impl->filter_normal = &wuffs_vp8__decoder__filter_normal_x86_sse42;
+    impl->filter_simple = &wuffs_vp8__decoder__filter_simple_x86_sse42;
+    impl->inverse_dct_full = &wuffs_vp8__decoder__inverse_dct_full_x86_sse42;
+    impl->predict_uv8 = &wuffs_vp8__decoder__predict_uv8_x86_sse42;
+    impl->predict_y16 = &wuffs_vp8__decoder__predict_y16_x86_sse42;
+    impl->predict_y4 = &wuffs_vp8__decoder__predict_y4_x86_sse42;
+    return true;
+  }
+#endif
+  return false;
+}
+
+// fill_vp8_random_bytes fills p[0 .. n] with pseudo-random bytes.
+void  //
+fill_vp8_random_bytes(uint8_t* p, size_t n, uint32_t seed) {
+  uint32_t x = seed;
+  for (size_t i = 0; i < n; i++) {
+    x = (x * 1103515245u) + 12345u;
+    p[i] = (uint8_t)(x >> 24);
+  }
+}
+
 void  //
 initialize_decoder_test_state(wuffs_vp8__decoder* dec) {
   // Initialize the top and left luma (Y) pixels to the digits of pi.
@@ -151,30 +235,38 @@ test_wuffs_vp8_decode_inverse_dct_full() {
   dec.private_data.f_mb_coeffs[0][0x0E] = 0x36;
   dec.private_data.f_mb_coeffs[0][0x0F] = 0x56;
 
-  memset(dec.private_impl.f_yuv_cache, 0xC0,
-         sizeof(dec.private_impl.f_yuv_cache));
-
   const uint32_t w0 = 0xFFACFBBC;
   const uint32_t w1 = 0x92ABA8C6;
   const uint32_t w2 = 0xABB6C1C6;
   const uint32_t w3 = 0x8FDFC5A7;
 
-  wuffs_vp8__decoder__inverse_dct_full(&dec, 8, 1, 0);
-
-  uint32_t h0 = wuffs_base__peek_u32be__no_bounds_check(
-      &dec.private_impl.f_yuv_cache[1][8]);
-  uint32_t h1 = wuffs_base__peek_u32be__no_bounds_check(
-      &dec.private_impl.f_yuv_cache[2][8]);
-  uint32_t h2 = wuffs_base__peek_u32be__no_bounds_check(
-      &dec.private_impl.f_yuv_cache[3][8]);
-  uint32_t h3 = wuffs_base__peek_u32be__no_bounds_check(
-      &dec.private_impl.f_yuv_cache[4][8]);
-
-  if ((h0 != w0) || (h1 != w1) || (h2 != w2) || (h3 != w3)) {
-    RETURN_FAIL(
-        "\nhave %08" PRIX32 " %08" PRIX32 " %08" PRIX32 " %08" PRIX32   //
-        "\nwant %08" PRIX32 " %08" PRIX32 " %08" PRIX32 " %08" PRIX32,  //
-        h0, h1, h2, h3, w0, w1, w2, w3);
+  for (int f = 0; f < VP8_NUM_IMPLEMENTATIONS; f++) {
+    vp8_implementation impl;
+    if (!vp8_get_implementation(f, &impl)) {
+      continue;
+    }
+
+    memset(dec.private_impl.f_yuv_cache, 0xC0,
+           sizeof(dec.private_impl.f_yuv_cache));
+
+    (*impl.inverse_dct_full)(&dec, 8, 1, 0);
+
+    uint32_t h0 = wuffs_base__peek_u32be__no_bounds_check(
+        &dec.private_impl.f_yuv_cache[1][8]);
+    uint32_t h1 = wuffs_base__peek_u32be__no_bounds_check(
+        &dec.private_impl.f_yuv_cache[2][8]);
+    uint32_t h2 = wuffs_base__peek_u32be__no_bounds_check(
+        &dec.private_impl.f_yuv_cache[3][8]);
+    uint32_t h3 = wuffs_base__peek_u32be__no_bounds_check(
+        &dec.private_impl.f_yuv_cache[4][8]);
+
+    if ((h0 != w0) || (h1 != w1) || (h2 != w2) || (h3 != w3)) {
+      RETURN_FAIL(
+          "%s:"                                                           //
+          "\nhave %08" PRIX32 " %08" PRIX32 " %08" PRIX32 " %08" PRIX32   //
+          "\nwant %08" PRIX32 " %08" PRIX32 " %08" PRIX32 " %08" PRIX32,  //
+          impl.name, h0, h1, h2, h3, w0, w1, w2, w3);
+    }
   }
   return NULL;
 }
@@ -259,50 +351,60 @@ test_wuffs_vp8_decode_predict_uv8() {
   };
 
   wuffs_vp8__decoder dec = {0};
-  for (int mode = 0; mode < 13; mode++) {
-    uint64_t w0 = test_cases[mode][0];
-    uint64_t w1 = test_cases[mode][1];
-    uint64_t w2 = test_cases[mode][2];
-    uint64_t w3 = test_cases[mode][3];
-    uint64_t w4 = test_cases[mode][4];
-    uint64_t w5 = test_cases[mode][5];
-    uint64_t w6 = test_cases[mode][6];
-    uint64_t w7 = test_cases[mode][7];
-
-    if (w0 == 0) {
+  for (int f = 0; f < VP8_NUM_IMPLEMENTATIONS; f++) {
+    vp8_implementation impl;
+    if (!vp8_get_implementation(f, &impl)) {
       continue;
     }
 
-    initialize_decoder_test_state(&dec);
-
-    wuffs_vp8__decoder__predict_uv8(&dec, 0, mode);
-
-    uint64_t h0 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x12][8]);
-    uint64_t h1 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x13][8]);
-    uint64_t h2 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x14][8]);
-    uint64_t h3 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x15][8]);
-    uint64_t h4 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x16][8]);
-    uint64_t h5 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x17][8]);
-    uint64_t h6 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x18][8]);
-    uint64_t h7 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x19][8]);
-
-    if ((h0 != w0) || (h1 != w1) || (h2 != w2) || (h3 != w3) ||  //
-        (h4 != w4) || (h5 != w5) || (h6 != w6) || (h7 != w7)) {
-      RETURN_FAIL(
-          "mode=%d:"                                                         //
-          "\nhave %016" PRIX64 " %016" PRIX64 " %016" PRIX64 " %016" PRIX64  //
-          " %016" PRIX64 " %016" PRIX64 " %016" PRIX64 " %016" PRIX64        //
-          "\nwant %016" PRIX64 " %016" PRIX64 " %016" PRIX64 " %016" PRIX64  //
-          " %016" PRIX64 " %016" PRIX64 " %016" PRIX64 " %016" PRIX64,       //
-          mode, h0, h1, h2, h3, h4, h5, h6, h7, w0, w1, w2, w3, w4, w5, w6, w7);
+    for (int mode = 0; mode < 13; mode++) {
+      uint64_t w0 = test_cases[mode][0];
+      uint64_t w1 = test_cases[mode][1];
+      uint64_t w2 = test_cases[mode][2];
+      uint64_t w3 = test_cases[mode][3];
+      uint64_t w4 = test_cases[mode][4];
+      uint64_t w5 = test_cases[mode][5];
+      uint64_t w6 = test_cases[mode][6];
+      uint64_t w7 = test_cases[mode][7];
+
+      if (w0 == 0) {
+        continue;
+      }
+
+      initialize_decoder_test_state(&dec);
+
+      (*impl.predict_uv8)(&dec, 0, mode);
+
+      uint64_t h0 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x12][8]);
+      uint64_t h1 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x13][8]);
+      uint64_t h2 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x14][8]);
+      uint64_t h3 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x15][8]);
+      uint64_t h4 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x16][8]);
+      uint64_t h5 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x17][8]);
+      uint64_t h6 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x18][8]);
+      uint64_t h7 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x19][8]);
+
+      if ((h0 != w0) || (h1 != w1) || (h2 != w2) || (h3 != w3) ||  //
+          (h4 != w4) || (h5 != w5) || (h6 != w6) || (h7 != w7)) {
+        RETURN_FAIL(
+            "%s: mode=%d:"                                      //
+            "\nhave %016" PRIX64 " %016" PRIX64 " %016" PRIX64  //
+            " %016" PRIX64 " %016" PRIX64 " %016" PRIX64        //
+            " %016" PRIX64 " %016" PRIX64                       //
+            "\nwant %016" PRIX64 " %016" PRIX64 " %016" PRIX64  //
+            " %016" PRIX64 " %016" PRIX64 " %016" PRIX64        //
+            " %016" PRIX64 " %016" PRIX64,                      //
+            impl.name, mode, h0, h1, h2, h3, h4, h5, h6, h7,    //
+            w0, w1, w2, w3, w4, w5, w6, w7);
+      }
     }
   }
 
@@ -347,56 +449,63 @@ test_wuffs_vp8_decode_predict_y16() {
   };
 
   wuffs_vp8__decoder dec = {0};
-  for (int mode = 0; mode < 13; mode++) {
-    uint64_t w0 = test_cases[mode][0];
-    uint64_t w1 = test_cases[mode][1];
-    uint64_t w2 = test_cases[mode][2];
-    uint64_t w3 = test_cases[mode][3];
-    uint64_t w4 = test_cases[mode][4];
-    uint64_t w5 = test_cases[mode][5];
-    uint64_t w6 = test_cases[mode][6];
-    uint64_t w7 = test_cases[mode][7];
-    uint64_t w8 = test_cases[mode][8];
-
-    if (w0 == 0) {
+  for (int f = 0; f < VP8_NUM_IMPLEMENTATIONS; f++) {
+    vp8_implementation impl;
+    if (!vp8_get_implementation(f, &impl)) {
       continue;
     }
 
-    initialize_decoder_test_state(&dec);
-
-    wuffs_vp8__decoder__predict_y16(&dec, mode);
-
-    uint64_t h0 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x01][8]);
-    uint64_t h1 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x02][8]);
-    uint64_t h2 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x03][8]);
-    uint64_t h3 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x04][8]);
-    uint64_t h4 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x05][8]);
-    uint64_t h5 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x06][8]);
-    uint64_t h6 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x07][8]);
-    uint64_t h7 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x08][8]);
-    uint64_t h8 = wuffs_base__peek_u64be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[0x09][8]);
-
-    if ((h0 != w0) || (h1 != w1) || (h2 != w2) || (h3 != w3) ||  //
-        (h4 != w4) || (h5 != w5) || (h6 != w6) || (h7 != w7) || (h8 != w8)) {
-      RETURN_FAIL(
-          "mode=%d:"                                                         //
-          "\nhave %016" PRIX64 " %016" PRIX64 " %016" PRIX64 " %016" PRIX64  //
-          " %016" PRIX64 " %016" PRIX64 " %016" PRIX64 " %016" PRIX64        //
-          " %016" PRIX64                                                     //
-          "\nwant %016" PRIX64 " %016" PRIX64 " %016" PRIX64 " %016" PRIX64  //
-          " %016" PRIX64 " %016" PRIX64 " %016" PRIX64 " %016" PRIX64        //
-          " %016" PRIX64,                                                    //
-          mode, h0, h1, h2, h3, h4, h5, h6, h7, h8,                          //
-          w0, w1, w2, w3, w4, w5, w6, w7, w8);
+    for (int mode = 0; mode < 13; mode++) {
+      uint64_t w0 = test_cases[mode][0];
+      uint64_t w1 = test_cases[mode][1];
+      uint64_t w2 = test_cases[mode][2];
+      uint64_t w3 = test_cases[mode][3];
+      uint64_t w4 = test_cases[mode][4];
+      uint64_t w5 = test_cases[mode][5];
+      uint64_t w6 = test_cases[mode][6];
+      uint64_t w7 = test_cases[mode][7];
+      uint64_t w8 = test_cases[mode][8];
+
+      if (w0 == 0) {
+        continue;
+      }
+
+      initialize_decoder_test_state(&dec);
+
+      (*impl.predict_y16)(&dec, mode);
+
+      uint64_t h0 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x01][8]);
+      uint64_t h1 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x02][8]);
+      uint64_t h2 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x03][8]);
+      uint64_t h3 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x04][8]);
+      uint64_t h4 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x05][8]);
+      uint64_t h5 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x06][8]);
+      uint64_t h6 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x07][8]);
+      uint64_t h7 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x08][8]);
+      uint64_t h8 = wuffs_base__peek_u64be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[0x09][8]);
+
+      if ((h0 != w0) || (h1 != w1) || (h2 != w2) || (h3 != w3) ||  //
+          (h4 != w4) || (h5 != w5) || (h6 != w6) || (h7 != w7) || (h8 != w8)) {
+        RETURN_FAIL(
+            "%s: mode=%d:"                                        //
+            "\nhave %016" PRIX64 " %016" PRIX64 " %016" PRIX64    //
+            " %016" PRIX64 " %016" PRIX64 " %016" PRIX64          //
+            " %016" PRIX64 " %016" PRIX64 " %016" PRIX64          //
+            "\nwant %016" PRIX64 " %016" PRIX64 " %016" PRIX64    //
+            " %016" PRIX64 " %016" PRIX64 " %016" PRIX64          //
+            " %016" PRIX64 " %016" PRIX64 " %016" PRIX64,         //
+            impl.name, mode, h0, h1, h2, h3, h4, h5, h6, h7, h8,  //
+            w0, w1, w2, w3, w4, w5, w6, w7, w8);
+      }
     }
   }
 
@@ -421,32 +530,256 @@ test_wuffs_vp8_decode_predict_y4() {
   };
 
   wuffs_vp8__decoder dec = {0};
-  for (int mode = 0; mode < 10; mode++) {
-    uint32_t w0 = test_cases[mode][0];
-    uint32_t w1 = test_cases[mode][1];
-    uint32_t w2 = test_cases[mode][2];
-    uint32_t w3 = test_cases[mode][3];
+  for (int f = 0; f < VP8_NUM_IMPLEMENTATIONS; f++) {
+    vp8_implementation impl;
+    if (!vp8_get_implementation(f, &impl)) {
+      continue;
+    }
 
-    initialize_decoder_test_state(&dec);
+    for (int mode = 0; mode < 10; mode++) {
+      uint32_t w0 = test_cases[mode][0];
+      uint32_t w1 = test_cases[mode][1];
+      uint32_t w2 = test_cases[mode][2];
+      uint32_t w3 = test_cases[mode][3];
+
+      initialize_decoder_test_state(&dec);
+
+      dec.private_impl.f_mb_subblock_modes[0] = mode;
+      (*impl.predict_y4)(&dec, 0);
+
+      uint32_t h0 = wuffs_base__peek_u32be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[1][8]);
+      uint32_t h1 = wuffs_base__peek_u32be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[2][8]);
+      uint32_t h2 = wuffs_base__peek_u32be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[3][8]);
+      uint32_t h3 = wuffs_base__peek_u32be__no_bounds_check(
+          &dec.private_impl.f_yuv_cache[4][8]);
+
+      if ((h0 != w0) || (h1 != w1) || (h2 != w2) || (h3 != w3)) {
+        RETURN_FAIL(
+            "%s: mode=%d:"                                                  //
+            "\nhave %08" PRIX32 " %08" PRIX32 " %08" PRIX32 " %08" PRIX32   //
+            "\nwant %08" PRIX32 " %08" PRIX32 " %08" PRIX32 " %08" PRIX32,  //
+            impl.name, mode, h0, h1, h2, h3, w0, w1, w2, w3);
+      }
+    }
+  }
+  return NULL;
+}
 
-    dec.private_impl.f_mb_subblock_modes[0] = mode;
-    wuffs_vp8__decoder__predict_y4(&dec, 0);
+// The *_implementations tests below check that every implementation of a
+// SIMD-accelerated method produces the same output as the portable one, given
+// the same pseudo-random input.
 
-    uint32_t h0 = wuffs_base__peek_u32be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[1][8]);
-    uint32_t h1 = wuffs_base__peek_u32be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[2][8]);
-    uint32_t h2 = wuffs_base__peek_u32be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[3][8]);
-    uint32_t h3 = wuffs_base__peek_u32be__no_bounds_check(
-        &dec.private_impl.f_yuv_cache[4][8]);
+const char*  //
+test_wuffs_vp8_decode_filter_inter_block_implementations() {
+  CHECK_FOCUS(__func__);
 
-    if ((h0 != w0) || (h1 != w1) || (h2 != w2) || (h3 != w3)) {
-      RETURN_FAIL(
-          "mode=%d:"                                                      //
-          "\nhave %08" PRIX32 " %08" PRIX32 " %08" PRIX32 " %08" PRIX32   //
-          "\nwant %08" PRIX32 " %08" PRIX32 " %08" PRIX32 " %08" PRIX32,  //
-          mode, h0, h1, h2, h3, w0, w1, w2, w3);
+  static const uint32_t sizes[3] = {4, 8, 16};
+
+  uint8_t want[sizeof(((wuffs_vp8__decoder*)NULL)->private_impl.f_yuv_cache)];
+  uint8_t src[sizeof(want)];
+
+  wuffs_vp8__decoder dec = {0};
+  for (uint32_t seed = 1; seed <= 64; seed++) {
+    fill_vp8_random_bytes(src, sizeof(src), seed);
+    fill_vp8_random_bytes(&dec.private_data.f_mc_cache[0][0],
+                          sizeof(dec.private_data.f_mc_cache), ~seed);
+
+    // Each test case i is (w, h, fx, fy): 9 block sizes and 64 filter pairs.
+    // Odd seeds use the bilinear filters (MC_FILTER_TAPS indexes 8 ..= 15)
+    // instead of the six-tap ones (indexes 0 ..= 7).
+    for (int i = 0; i < (9 * 64); i++) {
+      uint32_t w = sizes[i % 3];
+      uint32_t h = sizes[(i / 3) % 3];
+      uint32_t fx = ((i / 9) & 7) | ((seed & 1) << 3);
+      uint32_t fy = ((i / 72) & 7) | ((seed & 1) << 3);
+      uint32_t cachex = 8 + (w * (seed % ((32 - 8) / w)));
+      uint32_t cachey = 1 + (seed % (26 - 1 - h));
+
+      for (int f = 0; f < VP8_NUM_IMPLEMENTATIONS; f++) {
+        vp8_implementation impl;
+        if (!vp8_get_implementation(f, &impl)) {
+          continue;
+        }
+        memcpy(dec.private_impl.f_yuv_cache, src, sizeof(src));
+        (*impl.filter_inter_block)(&dec, w, h, fx, fy, cachex, cachey);
+        if (f == 0) {
+          memcpy(want, dec.private_impl.f_yuv_cache, sizeof(want));
+        } else if (memcmp(dec.private_impl.f_yuv_cache, want, sizeof(want))) {
+          RETURN_FAIL("%s: seed=%" PRIu32 ", w=%" PRIu32 ", h=%" PRIu32
+                      ", fx=%" PRIu32 ", fy=%" PRIu32 ": yuv_cache differs",
+                      impl.name, seed, w, h, fx, fy);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_vp8_decode_filter_implementations() {
+  CHECK_FOCUS(__func__);
+
+  // The workbuf holds a 3x2 macroblock image: 48x32 luma (Y) pixels followed
+  // by two 24x16 chroma (U, V) planes.
+  enum {
+    mbw = 3,
+    mbh = 2,
+    y_stride = mbw * 16,
+    uv_stride = mbw * 8,
+    y_end = y_stride * mbh * 16,
+    u_end = y_end + (uv_stride * mbh * 8),
+    v_end = u_end + (uv_stride * mbh * 8),
+  };
+  uint8_t have[v_end];
+  uint8_t want[v_end];
+  uint8_t src[v_end];
+
+  wuffs_vp8__decoder dec = {0};
+  dec.private_impl.f_mbw = mbw;
+  dec.private_impl.f_workbuf_yuv_y_stride = y_stride;
+  dec.private_impl.f_workbuf_yuv_uv_stride = uv_stride;
+  dec.private_impl.f_workbuf_yuv_y_end = y_end;
+  dec.private_impl.f_workbuf_yuv_u_end = u_end;
+  dec.private_impl.f_workbuf_yuv_v_end = v_end;
+
+  for (uint32_t seed = 1; seed <= 64; seed++) {
+    // Small pixel deltas exercise the filters. Large ones exercise their
+    // "don't filter across a real edge" thresholds. Vary the amplitude.
+    fill_vp8_random_bytes(src, v_end, seed);
+    uint32_t amplitude = 4u << (2 * (seed & 3));
+    for (size_t i = 0; i < v_end; i++) {
+      src[i] = (uint8_t)(0x60 + (src[i] % amplitude));
+    }
+
+    // Mimic decode_header_partition's loop_filters packing, with a random
+    // level, ilevel, hlevel and inner. Index 7 is "no filtering".
+    uint8_t params[8 * 4];
+    fill_vp8_random_bytes(params, sizeof(params), ~seed);
+    for (int i = 0; i < 7; i++) {
+      uint32_t level = params[(4 * i) + 0] & 63;
+      uint32_t ilevel = 1 + (params[(4 * i) + 1] % 63);
+      uint32_t hlevel = (level < 15) ? 0 : (level < 40) ? 1 : 2;
+      uint32_t inner = params[(4 * i) + 2] & 1;
+      dec.private_impl.f_loop_filters[i] = ((2 * level) + ilevel) |
+                                           (ilevel << 8) | (hlevel << 16) |
+                                           (inner << 31);
+    }
+    dec.private_impl.f_loop_filters[7] = 0;
+    for (int mbx = 0; mbx < mbw; mbx++) {
+      dec.private_data.f_mb_filters[0][mbx] = params[(3 * mbx) + 3] & 15;
+      dec.private_data.f_mb_filters[1][mbx] = params[(3 * mbx) + 7] & 15;
+    }
+
+    for (int simple = 0; simple < 2; simple++) {
+      for (int f = 0; f < VP8_NUM_IMPLEMENTATIONS; f++) {
+        vp8_implementation impl;
+        if (!vp8_get_implementation(f, &impl)) {
+          continue;
+        }
+        uint8_t* dst = (f == 0) ? want : have;
+        memcpy(dst, src, v_end);
+        for (uint32_t mby = 0; mby < mbh; mby++) {
+          (*(simple ? impl.filter_simple : impl.filter_normal))(
+              &dec, wuffs_base__make_slice_u8(dst, v_end), mby);
+        }
+        if (f == 0) {
+          continue;
+        }
+        for (size_t i = 0; i < v_end; i++) {
+          if (have[i] != want[i]) {
+            RETURN_FAIL("%s: seed=%" PRIu32 ", simple=%d, i=%zu: have 0x%02X, "
+                        "want 0x%02X",
+                        impl.name, seed, simple, i, have[i], want[i]);
+          }
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_vp8_decode_inverse_dct_full_implementations() {
+  CHECK_FOCUS(__func__);
+
+  uint8_t want[sizeof(((wuffs_vp8__decoder*)NULL)->private_impl.f_yuv_cache)];
+  uint8_t src[sizeof(want)];
+
+  wuffs_vp8__decoder dec = {0};
+  for (uint32_t seed = 1; seed <= 64; seed++) {
+    fill_vp8_random_bytes(src, sizeof(src), seed);
+    fill_vp8_random_bytes((uint8_t*)(void*)dec.private_data.f_mb_coeffs[0],
+                          sizeof(dec.private_data.f_mb_coeffs[0]), ~seed);
+    // Also check the coefficient ranges that real (dequantized) input uses.
+    if (seed & 1) {
+      for (int i = 0; i < 16; i++) {
+        uint16_t c = dec.private_data.f_mb_coeffs[0][i];
+        dec.private_data.f_mb_coeffs[0][i] = (uint16_t)((c & 0x0FFF) - 0x0800);
+      }
+    }
+    uint32_t cachex = 8 + (4 * (seed % 6));
+    uint32_t cachey = 1 + (seed % 22);
+
+    for (int f = 0; f < VP8_NUM_IMPLEMENTATIONS; f++) {
+      vp8_implementation impl;
+      if (!vp8_get_implementation(f, &impl)) {
+        continue;
+      }
+      memcpy(dec.private_impl.f_yuv_cache, src, sizeof(src));
+      (*impl.inverse_dct_full)(&dec, cachex, cachey, 0);
+      if (f == 0) {
+        memcpy(want, dec.private_impl.f_yuv_cache, sizeof(want));
+      } else if (memcmp(dec.private_impl.f_yuv_cache, want, sizeof(want))) {
+        RETURN_FAIL("%s: seed=%" PRIu32 ": yuv_cache differs", impl.name,
+                    seed);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_vp8_decode_predict_implementations() {
+  CHECK_FOCUS(__func__);
+
+  // Modes 4 ..= 9 are only valid for predict_y4.
+  static const uint32_t y16_uv8_modes[7] = {0, 1, 2, 3, 10, 11, 12};
+
+  uint8_t want[sizeof(((wuffs_vp8__decoder*)NULL)->private_impl.f_yuv_cache)];
+  uint8_t src[sizeof(want)];
+
+  wuffs_vp8__decoder dec = {0};
+  for (uint32_t seed = 1; seed <= 16; seed++) {
+    fill_vp8_random_bytes(src, sizeof(src), seed);
+
+    // Each test case i is (method, b, mode): 160 cases of predict_y4 (16 b
+    // and 10 modes), 7 cases of predict_y16 and 14 cases of predict_uv8.
+    for (int i = 0; i < 181; i++) {
+      for (int f = 0; f < VP8_NUM_IMPLEMENTATIONS; f++) {
+        vp8_implementation impl;
+        if (!vp8_get_implementation(f, &impl)) {
+          continue;
+        }
+        memcpy(dec.private_impl.f_yuv_cache, src, sizeof(src));
+        if (i < 160) {
+          dec.private_impl.f_mb_subblock_modes[i & 15] = (uint8_t)(i >> 4);
+          (*impl.predict_y4)(&dec, i & 15);
+        } else if (i < 167) {
+          (*impl.predict_y16)(&dec, y16_uv8_modes[i - 160]);
+        } else {
+          (*impl.predict_uv8)(&dec, (i - 167) & 1,
+                              y16_uv8_modes[(i - 167) >> 1]);
+        }
+        if (f == 0) {
+          memcpy(want, dec.private_impl.f_yuv_cache, sizeof(want));
+        } else if (memcmp(dec.private_impl.f_yuv_cache, want, sizeof(want))) {
+          RETURN_FAIL("%s: seed=%" PRIu32 ", i=%d: yuv_cache differs",
+                      impl.name, seed, i);
+        }
+      }
     }
   }
   return NULL;
@@ -476,8 +809,12 @@ test_wuffs_vp8_decode_predict_y4() {
 
 proc g_tests[] = {
 
+    test_wuffs_vp8_decode_filter_implementations,
+    test_wuffs_vp8_decode_filter_inter_block_implementations,
     test_wuffs_vp8_decode_inverse_dct_full,
+    test_wuffs_vp8_decode_inverse_dct_full_implementations,
     test_wuffs_vp8_decode_inverse_wht,
+    test_wuffs_vp8_decode_predict_implementations,
     test_wuffs_vp8_decode_predict_uv8,
     test_wuffs_vp8_decode_predict_y16,
     test_wuffs_vp8_decode_predict_y4,
@@ -575,6 +575,205 @@ test_wuffs_upsample_inv_h2v1() {
   return check_io_buffers_equal("", &have, &want);
 }
 
+const char*  //
+test_wuffs_swizzle_ycck_x86_avx2() {
+  CHECK_FOCUS(__func__);
+
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+  if (!wuffs_base__cpu_arch__have_x86_avx2()) {
+    return NULL;
+  }
+
+  // Fill the source rows with pseudo-random samples.
+  uint8_t src[4][256];
+  uint32_t rng = 0x12345678u;
+  for (int c = 0; c < 4; c++) {
+    for (int i = 0; i < 256; i++) {
+      rng = (rng * 1103515245u) + 12345u;
+      src[c][i] = (uint8_t)(rng >> 24u);
+    }
+  }
+
+  const uint32_t widths[] = {1, 31, 32, 33, 100, 255};
+
+  // The SIMD (have) and non-SIMD (want) convert funcs should produce
+  // identical pixels.
+  const struct {
+    uint32_t pixfmt_repr;
+    uint32_t bytes_per_pixel;
+    wuffs_private_impl__swizzle_ycc__convert_3_func have_func3;
+    wuffs_private_impl__swizzle_ycc__convert_3_func want_func3;
+    wuffs_private_impl__swizzle_ycc__convert_4_func have_func4;
+    wuffs_private_impl__swizzle_ycc__convert_4_func want_func4;
+  } convs[] = {
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGR,
+          .bytes_per_pixel = 3,
+          .have_func3 =
+              &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgr_x86_avx2,
+          .want_func3 = &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgr,
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGB,
+          .bytes_per_pixel = 3,
+          .have_func3 =
+              &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgb_x86_avx2,
+          .want_func3 = &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgb,
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRX,
+          .bytes_per_pixel = 4,
+          .have_func3 =
+              &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgrx_x86_avx2,
+          .want_func3 =
+              &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_bgrx,
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBX,
+          .bytes_per_pixel = 4,
+          .have_func3 =
+              &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgbx_x86_avx2,
+          .want_func3 =
+              &wuffs_private_impl__swizzle_ycc_bt601fr__convert_3_rgbx,
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRX,
+          .bytes_per_pixel = 4,
+          .have_func4 =
+              &wuffs_private_impl__swizzle_ycck__convert_4_bgrx_x86_avx2,
+          .want_func4 = &wuffs_private_impl__swizzle_ycck__convert_4_general,
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBX,
+          .bytes_per_pixel = 4,
+          .have_func4 =
+              &wuffs_private_impl__swizzle_ycck__convert_4_rgbx_x86_avx2,
+          .want_func4 = &wuffs_private_impl__swizzle_ycck__convert_4_general,
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRX,
+          .bytes_per_pixel = 4,
+          .have_func4 =
+              &wuffs_private_impl__swizzle_cmyk__convert_4_bgrx_x86_avx2,
+          .want_func4 = &wuffs_private_impl__swizzle_cmyk__convert_4_general,
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBX,
+          .bytes_per_pixel = 4,
+          .have_func4 =
+              &wuffs_private_impl__swizzle_cmyk__convert_4_rgbx_x86_avx2,
+          .want_func4 = &wuffs_private_impl__swizzle_cmyk__convert_4_general,
+      },
+  };
+
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(convs); i++) {
+    wuffs_base__pixel_config pixcfg = ((wuffs_base__pixel_config){});
+    wuffs_base__pixel_config__set(&pixcfg, convs[i].pixfmt_repr,
+                                  WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, 256, 1);
+    wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice (have)",
+                 wuffs_base__pixel_buffer__set_from_slice(&have_pb, &pixcfg,
+                                                          g_have_slice_u8));
+    wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice (want)",
+                 wuffs_base__pixel_buffer__set_from_slice(&want_pb, &pixcfg,
+                                                          g_want_slice_u8));
+
+    for (size_t w = 0; w < WUFFS_TESTLIB_ARRAY_SIZE(widths); w++) {
+      if (convs[i].have_func3) {
+        (*convs[i].have_func3)(&have_pb, 0, widths[w], 0,  //
+                               src[0], src[1], src[2]);
+        (*convs[i].want_func3)(&want_pb, 0, widths[w], 0,  //
+                               src[0], src[1], src[2]);
+      } else {
+        (*convs[i].have_func4)(&have_pb, 0, widths[w], 0,  //
+                               src[0], src[1], src[2], src[3]);
+        (*convs[i].want_func4)(&want_pb, 0, widths[w], 0,  //
+                               src[0], src[1], src[2], src[3]);
+      }
+
+      wuffs_base__io_buffer have = wuffs_base__ptr_u8__reader(
+          g_have_array_u8, widths[w] * convs[i].bytes_per_pixel, true);
+      wuffs_base__io_buffer want = wuffs_base__ptr_u8__reader(
+          g_want_array_u8, widths[w] * convs[i].bytes_per_pixel, true);
+      char prefix[256];
+      snprintf(prefix, 256, "convs[%zu], width=%" PRIu32 ": ", i, widths[w]);
+      CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+    }
+  }
+
+  // Likewise for the upsample funcs. The (first_column, last_column) = (false,
+  // false) case reads one sample either side of the nominal source row, so
+  // start that source row at src[0] + 1.
+  const struct {
+    uint32_t inv_h;
+    uint32_t h1v2_bias;
+    wuffs_private_impl__swizzle_ycc__upsample_func have_func;
+    wuffs_private_impl__swizzle_ycc__upsample_func want_func;
+  } ups[] = {
+      {
+          .inv_h = 2,
+          .h1v2_bias = 0,
+          .have_func =
+              &wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box_x86_avx2,
+          .want_func = &wuffs_private_impl__swizzle_ycc__upsample_inv_h2vn_box,
+      },
+#if defined(__GNUC__) && !defined(__clang__)
+  // No-op.
+#else
+      {
+          .inv_h = 1,
+          .h1v2_bias = 1,
+          .have_func =
+              &wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2,
+          .want_func =
+              &wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle,
+      },
+      {
+          .inv_h = 1,
+          .h1v2_bias = 2,
+          .have_func =
+              &wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2,
+          .want_func =
+              &wuffs_private_impl__swizzle_ycc__upsample_inv_h1v2_triangle,
+      },
+      {
+          .inv_h = 2,
+          .h1v2_bias = 0,
+          .have_func =
+              &wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2,
+          .want_func =
+              &wuffs_private_impl__swizzle_ycc__upsample_inv_h2v1_triangle,
+      },
+#endif
+  };
+
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(ups); i++) {
+    for (size_t w = 0; w < WUFFS_TESTLIB_ARRAY_SIZE(widths); w++) {
+      for (int edges = 0; edges < 2; edges++) {
+        const uint8_t* have_ptr = (*ups[i].have_func)(
+            g_have_array_u8, src[0] + (1 - edges), src[1] + (1 - edges),
+            widths[w], ups[i].h1v2_bias, edges, edges);
+        const uint8_t* want_ptr = (*ups[i].want_func)(
+            g_want_array_u8, src[0] + (1 - edges), src[1] + (1 - edges),
+            widths[w], ups[i].h1v2_bias, edges, edges);
+
+        wuffs_base__io_buffer have = wuffs_base__ptr_u8__reader(
+            (uint8_t*)(void*)have_ptr, widths[w] * ups[i].inv_h, true);
+        wuffs_base__io_buffer want = wuffs_base__ptr_u8__reader(
+            (uint8_t*)(void*)want_ptr, widths[w] * ups[i].inv_h, true);
+        char prefix[256];
+        snprintf(prefix, 256, "ups[%zu], width=%" PRIu32 ", edges=%d: ", i,
+                 widths[w], edges);
+        CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+      }
+    }
+  }
+#endif  // defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+
+  return NULL;
+}
+
 // ---------------- WBMP Tests
 
 const char*  //
@@ -832,6 +1031,7 @@ proc g_tests[] = {
     test_wuffs_color_ycc_as_color_u32,
     test_wuffs_pixel_buffer_fill_rect,
     test_wuffs_pixel_swizzler_swizzle,
+    test_wuffs_swizzle_ycck_x86_avx2,
     test_wuffs_upsample_inv_h2v1,
 
     test_wuffs_wbmp_decode_frame_config,
@@ -0,0 +1,360 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 <LICENSE-APACHE or
+// https://www.apache.org/licenses/LICENSE-2.0> or the MIT license
+// <LICENSE-MIT or https://opensource.org/licenses/MIT>, at your
+// option. This file may not be copied, modified, or distributed
+// except according to those terms.
+//
+// SPDX-License-Identifier: Apache-2.0 OR MIT
+
+// ----------------
+
+/*
+This test program is typically run indirectly, by the "wuffs test" or "wuffs
+bench" commands. These commands take an optional "-mimic" flag to check that
+Wuffs' output mimics (i.e. exactly matches) other libraries' output, such as
+giflib for GIF, libpng for PNG, etc.
+
+To manually run this test:
+
+for CC in clang gcc; do
+  $CC -std=c99 -Wall -Werror webm.c && ./a.out
+  rm -f a.out
+done
+
+Each edition should print "PASS", amongst other information, and exit(0).
+
+Add the "wuffs mimic cflags" (everything after the colon below) to the C
+compiler flags (after the .c file) to run the mimic tests.
+
+To manually run the benchmarks, replace "-Wall -Werror" with "-O3" and replace
+the first "./a.out" with "./a.out -bench". Combine these changes with the
+"wuffs mimic cflags" to run the mimic benchmarks.
+*/
+
+// ¿ wuffs mimic cflags: -DWUFFS_MIMIC
+
+// Wuffs ships as a "single file C library" or "header file library" as per
+// https://github.com/nothings/stb/blob/master/docs/stb_howto.txt
+//
+// To use that single file as a "foo.c"-like implementation, instead of a
+// "foo.h"-like header, #define WUFFS_IMPLEMENTATION before #include'ing or
+// compiling it.
+#define WUFFS_IMPLEMENTATION
+
+// Defining the WUFFS_CONFIG__MODULE* macros are optional, but it lets users of
+// release/c/etc.c choose which parts of Wuffs to build. That file contains the
+// entire Wuffs standard library, implementing a variety of codecs and file
+// formats. Without this macro definition, an optimizing compiler or linker may
+// very well discard Wuffs code for unused codecs, but listing the Wuffs
+// modules we use makes that process explicit. Preprocessing means that such
+// code simply isn't compiled.
+#define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__BASE
+#define WUFFS_CONFIG__MODULE__CRC32
+#define WUFFS_CONFIG__MODULE__VP8
+#define WUFFS_CONFIG__MODULE__WEBM
+
+// If building this program in an environment that doesn't easily accommodate
+// relative includes, you can use the script/inline-c-relative-includes.go
+// program to generate a stand-alone C file.
+#include "../../../release/c/wuffs-unsupported-snapshot.c"
+#include "../testlib/testlib.c"
+#ifdef WUFFS_MIMIC
+// No mimic library.
+#endif
+
+static wuffs_webm__decoder g_webm_decoder;
+
+// ---------------- WebM Tests
+
+// g_muybridge_webm_checksums holds the CRC-32 IEEE checksums of the Y, Cb and
+// Cr planes (concatenated, cropped to the frame size) of each frame of
+// test/data/muybridge.webm, as decoded by FFmpeg's libavcodec.
+static const uint32_t g_muybridge_webm_checksums[15] = {
+    0x1178707E, 0x4970CE4A, 0x3B173628, 0x60839FA9, 0xEAEDCC9B,
+    0xC43CA4D9, 0xDB061CFF, 0x3362AC7E, 0x0181DBE9, 0xFCE49F12,
+    0x62F2602D, 0x086F86A8, 0x681AAA16, 0x9AC6FC5C, 0xBEBFA0C2,
+};
+
+// checksum_planar_ycbcr sets *checksum to the CRC-32 IEEE checksum of pb's
+// three (4:2:0 subsampled) planes.
+const char*  //
+checksum_planar_ycbcr(uint32_t* checksum,
+                      wuffs_base__pixel_buffer* pb,
+                      uint32_t width,
+                      uint32_t height) {
+  wuffs_crc32__ieee_hasher hasher;
+  CHECK_STATUS("initialize", wuffs_crc32__ieee_hasher__initialize(
+                                 &hasher, sizeof hasher, WUFFS_VERSION,
+                                 WUFFS_INITIALIZE__DEFAULT_OPTIONS));
+  for (uint32_t p = 0; p < 3; p++) {
+    wuffs_base__table_u8 t = wuffs_base__pixel_buffer__plane(pb, p);
+    uint32_t w = p ? ((width + 1) / 2) : width;
+    uint32_t h = p ? ((height + 1) / 2) : height;
+    for (uint32_t y = 0; y < h; y++) {
+      *checksum = wuffs_crc32__ieee_hasher__update_u32(
+          &hasher, wuffs_base__make_slice_u8(t.ptr + (y * t.stride), w));
+    }
+  }
+  return NULL;
+}
+
+// do_test_wuffs_webm_decode_frames decodes every frame of
+// test/data/muybridge.webm, num_passes times (restarting at the first frame
+// between passes), reading at most rlimit bytes at a time.
+const char*  //
+do_test_wuffs_webm_decode_frames(uint64_t rlimit, int num_passes) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/muybridge.webm"));
+
+  wuffs_webm__decoder* dec = &g_webm_decoder;
+  CHECK_STATUS("initialize",
+               wuffs_webm__decoder__initialize(
+                   dec, sizeof *dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  while (true) {
+    wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+    wuffs_base__status status =
+        wuffs_webm__decoder__decode_image_config(dec, &ic, &limited_src);
+    src.meta.ri += limited_src.meta.ri;
+    if (status.repr != wuffs_base__suspension__short_read) {
+      CHECK_STATUS("decode_image_config", status);
+      break;
+    }
+  }
+
+  const uint32_t width = 30;
+  const uint32_t height = 20;
+  if ((wuffs_base__pixel_config__width(&ic.pixcfg) != width) ||
+      (wuffs_base__pixel_config__height(&ic.pixcfg) != height)) {
+    RETURN_FAIL("dimensions: have %" PRIu32 "x%" PRIu32 ", want %" PRIu32
+                "x%" PRIu32,
+                wuffs_base__pixel_config__width(&ic.pixcfg),
+                wuffs_base__pixel_config__height(&ic.pixcfg), width, height);
+  }
+  uint64_t first_frame_io_position =
+      wuffs_base__image_config__first_frame_io_position(&ic);
+
+  wuffs_base__pixel_config__set(&ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__YCBCR,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__420, width,
+                                height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+  for (int pass = 0; pass < num_passes; pass++) {
+    if (pass > 0) {
+      CHECK_STATUS("restart_frame",
+                   wuffs_webm__decoder__restart_frame(
+                       dec, 0, first_frame_io_position));
+      src.meta.ri = first_frame_io_position;
+    }
+
+    for (uint32_t i = 0; true; i++) {
+      wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+      wuffs_base__status status;
+      while (true) {
+        wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+        status = wuffs_webm__decoder__decode_frame_config(dec, &fc,
+                                                          &limited_src);
+        src.meta.ri += limited_src.meta.ri;
+        if (status.repr != wuffs_base__suspension__short_read) {
+          break;
+        }
+      }
+
+      if (i == WUFFS_TESTLIB_ARRAY_SIZE(g_muybridge_webm_checksums)) {
+        if (status.repr != wuffs_base__note__end_of_data) {
+          RETURN_FAIL("pass %d: decode_frame_config #%" PRIu32
+                      ": have \"%s\", want \"%s\"",
+                      pass, i, status.repr, wuffs_base__note__end_of_data);
+        }
+        break;
+      }
+      CHECK_STATUS("decode_frame_config", status);
+
+      if (wuffs_base__frame_config__index(&fc) != i) {
+        RETURN_FAIL("pass %d: index: have %" PRIu64 ", want %" PRIu32, pass,
+                    wuffs_base__frame_config__index(&fc), i);
+      }
+      // The clip is 10 frames per second.
+      wuffs_base__flicks want_duration = WUFFS_BASE__FLICKS_PER_SECOND / 10;
+      if (wuffs_base__frame_config__duration(&fc) != want_duration) {
+        RETURN_FAIL("pass %d, frame #%" PRIu32 ": duration: have %" PRId64
+                    ", want %" PRId64,
+                    pass, i, wuffs_base__frame_config__duration(&fc),
+                    want_duration);
+      }
+      if ((i == 0) &&
+          (wuffs_base__frame_config__io_position(&fc) !=
+           first_frame_io_position)) {
+        RETURN_FAIL("pass %d: io_position: have %" PRIu64 ", want %" PRIu64,
+                    pass, wuffs_base__frame_config__io_position(&fc),
+                    first_frame_io_position);
+      }
+
+      while (true) {
+        wuffs_base__io_buffer limited_src = make_limited_reader(src, rlimit);
+        status = wuffs_webm__decoder__decode_frame(
+            dec, &pb, &limited_src, WUFFS_BASE__PIXEL_BLEND__SRC,
+            g_work_slice_u8, NULL);
+        src.meta.ri += limited_src.meta.ri;
+        if (status.repr != wuffs_base__suspension__short_read) {
+          break;
+        }
+      }
+      if (!wuffs_base__status__is_ok(&status)) {
+        RETURN_FAIL("pass %d: decode_frame #%" PRIu32 ": \"%s\"", pass, i,
+                    status.repr);
+      }
+
+      uint32_t have = 0;
+      CHECK_STRING(checksum_planar_ycbcr(&have, &pb, width, height));
+      uint32_t want = g_muybridge_webm_checksums[i];
+      if (have != want) {
+        RETURN_FAIL("pass %d, frame #%" PRIu32 ": checksum: have 0x%08" PRIX32
+                    ", want 0x%08" PRIX32,
+                    pass, i, have, want);
+      }
+    }
+
+    uint64_t have_num_frames = wuffs_webm__decoder__num_decoded_frames(dec);
+    if (have_num_frames != 15) {
+      RETURN_FAIL("pass %d: num_decoded_frames: have %" PRIu64 ", want 15",
+                  pass, have_num_frames);
+    }
+  }
+  return NULL;
+}
+
+// --------
+
+const char*  //
+test_wuffs_webm_decode_frames() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_webm_decode_frames(UINT64_MAX, 1);
+}
+
+const char*  //
+test_wuffs_webm_decode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_webm__decoder* dec = &g_webm_decoder;
+  CHECK_STATUS("initialize",
+               wuffs_webm__decoder__initialize(
+                   dec, sizeof *dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__image_decoder(
+      wuffs_webm__decoder__upcast_as__wuffs_base__image_decoder(dec),
+      "test/data/muybridge.webm", 0, SIZE_MAX, 30, 20, 0xFF818181);
+}
+
+const char*  //
+test_wuffs_webm_decode_many_small_reads() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_webm_decode_frames(7, 1);
+}
+
+const char*  //
+test_wuffs_webm_decode_restart_frame() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_webm_decode_frames(UINT64_MAX, 2);
+}
+
+const char*  //
+test_wuffs_webm_decode_unsupported_doc_type() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/muybridge.webm"));
+
+  // Replace the EBML header's DocType, "webm", with "abcd".
+  const char* doc_type = "\x42\x82\x84webm";
+  for (size_t i = 0; true; i++) {
+    if ((i + 7) > src.meta.wi) {
+      RETURN_FAIL("could not find the DocType element");
+    } else if (!memcmp(src.data.ptr + i, doc_type, 7)) {
+      memcpy(src.data.ptr + i + 3, "abcd", 4);
+      break;
+    }
+  }
+
+  wuffs_webm__decoder* dec = &g_webm_decoder;
+  CHECK_STATUS("initialize",
+               wuffs_webm__decoder__initialize(
+                   dec, sizeof *dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  wuffs_base__status status =
+      wuffs_webm__decoder__decode_image_config(dec, &ic, &src);
+  if (status.repr != wuffs_webm__error__unsupported_webm_file) {
+    RETURN_FAIL("decode_image_config: have \"%s\", want \"%s\"", status.repr,
+                wuffs_webm__error__unsupported_webm_file);
+  }
+  return NULL;
+}
+
+// ---------------- Mimic Tests
+
+#ifdef WUFFS_MIMIC
+
+// No mimic tests.
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- WebM Benches
+
+// No WebM benches.
+
+// ---------------- Mimic Benches
+
+#ifdef WUFFS_MIMIC
+
+// No mimic benches.
+
+#endif  // WUFFS_MIMIC
+
+// ---------------- Manifest
+
+proc g_tests[] = {
+
+    test_wuffs_webm_decode_frames,
+    test_wuffs_webm_decode_interface,
+    test_wuffs_webm_decode_many_small_reads,
+    test_wuffs_webm_decode_restart_frame,
+    test_wuffs_webm_decode_unsupported_doc_type,
+
+#ifdef WUFFS_MIMIC
+
+// No mimic tests.
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+proc g_benches[] = {
+
+// No WebM benches.
+
+#ifdef WUFFS_MIMIC
+
+// No mimic benches.
+
+#endif  // WUFFS_MIMIC
+
+    NULL,
+};
+
+int  //
+main(int argc, char** argv) {
+  g_proc_package_name = "std/webm";
+  return test_main(argc, argv, g_tests, g_benches);
+}
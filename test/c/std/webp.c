@@ -65,6 +65,8 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 #endif
 
 static wuffs_webp__decoder g_webp_decoder;
+static wuffs_vp8__decoder g_vp8_delegates[8];
+static wuffs_webp__encoder g_webp_encoder;
 
 // ---------------- WebP Tests
 
@@ -87,6 +89,132 @@ wuffs_webp_decode(uint64_t* n_bytes_out,
 
 // --------
 
+// webp_transform_func is the signature of the predictor and cross color
+// transforms' implementations. subtract green's implementations, of type
+// webp_subtract_green_func, take neither width nor tile_data.
+typedef wuffs_base__empty_struct (*webp_transform_func)(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix,
+    uint32_t a_width,
+    wuffs_base__slice_u8 a_tile_data);
+
+typedef wuffs_base__empty_struct (*webp_subtract_green_func)(
+    wuffs_webp__decoder* self,
+    wuffs_base__slice_u8 a_pix);
+
+// webp_transform_implementation is one implementation of one transform.
+// Exactly one of its fields is non-NULL, unless the implementation is not
+// available.
+typedef struct {
+  webp_transform_func transform;
+  webp_subtract_green_func subtract_green;
+} webp_transform_implementation;
+
+// webp_transform_implementation_for returns the f'th implementation of the
+// transform_type'th transform (0 = predictor, 1 = cross color, 2 = subtract
+// green), or one with NULL fields if it is not available on this CPU. f = 0
+// is the choosy_default implementation. Higher f are (faster) SIMD
+// implementations.
+webp_transform_implementation  //
+webp_transform_implementation_for(uint32_t transform_type,
+                                  int f,
+                                  const char** func_name) {
+  webp_transform_implementation impl = {NULL, NULL};
+  *func_name = NULL;
+  if (f == 0) {
+    *func_name = "choosy_default";
+    switch (transform_type) {
+      case 0:
+        impl.transform =
+            wuffs_webp__decoder__apply_transform_predictor__choosy_default;
+        break;
+      case 1:
+        impl.transform =
+            wuffs_webp__decoder__apply_transform_cross_color__choosy_default;
+        break;
+      case 2:
+        impl.subtract_green =
+            wuffs_webp__decoder__apply_transform_subtract_green__choosy_default;
+        break;
+    }
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V2)
+  } else if ((f == 1) && wuffs_base__cpu_arch__have_x86_sse42()) {
+    *func_name = "x86_sse42";
+    switch (transform_type) {
+      case 0:
+        impl.transform =
+            wuffs_webp__decoder__apply_transform_predictor_x86_sse42;
+        break;
+      case 1:
+        impl.transform =
+            wuffs_webp__decoder__apply_transform_cross_color_x86_sse42;
+        break;
+      case 2:
+        impl.subtract_green =
+            wuffs_webp__decoder__apply_transform_subtract_green_x86_sse42;
+        break;
+    }
+#endif
+#if defined(WUFFS_PRIVATE_IMPL__CPU_ARCH__X86_64_V3)
+  } else if ((f == 2) && wuffs_base__cpu_arch__have_x86_avx2()) {
+    *func_name = "x86_avx2";
+    switch (transform_type) {
+      case 1:
+        impl.transform =
+            wuffs_webp__decoder__apply_transform_cross_color_x86_avx2;
+        break;
+      case 2:
+        impl.subtract_green =
+            wuffs_webp__decoder__apply_transform_subtract_green_x86_avx2;
+        break;
+    }
+#endif
+  }
+  return impl;
+}
+
+bool  //
+webp_transform_implementation_is_available(
+    const webp_transform_implementation* impl) {
+  return impl->transform || impl->subtract_green;
+}
+
+void  //
+webp_transform_implementation_run(const webp_transform_implementation* impl,
+                                  wuffs_webp__decoder* dec,
+                                  wuffs_base__slice_u8 pix,
+                                  uint32_t width,
+                                  wuffs_base__slice_u8 tile_data) {
+  if (impl->transform) {
+    (*impl->transform)(dec, pix, width, tile_data);
+  } else if (impl->subtract_green) {
+    (*impl->subtract_green)(dec, pix);
+  }
+}
+
+// fill_webp_transform_inputs fills pix with pseudo-random bytes and tile_data
+// with pseudo-random multipliers (for the cross color transform). Each tile's
+// predictor mode (the low 4 bits of its green byte) cycles through all 16
+// values, including the invalid modes 14 and 15.
+void  //
+fill_webp_transform_inputs(wuffs_base__slice_u8 pix,
+                           wuffs_base__slice_u8 tile_data) {
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < pix.len; i++) {
+    x = (x * 1103515245u) + 12345u;
+    pix.ptr[i] = (uint8_t)(x >> 24);
+  }
+  for (size_t i = 0; i < tile_data.len; i++) {
+    x = (x * 1103515245u) + 12345u;
+    tile_data.ptr[i] = (uint8_t)(x >> 24);
+    if ((i & 3) == 1) {
+      tile_data.ptr[i] = (uint8_t)((tile_data.ptr[i] & 0xF0) | ((i >> 2) & 15));
+    }
+  }
+}
+
+// --------
+
 const char*  //
 test_wuffs_webp_decode_interface_lossless() {
   CHECK_FOCUS(__func__);
@@ -128,6 +256,379 @@ test_wuffs_webp_decode_interface_vp8x_alpha_lossy() {
       36, 28, 0xFFF5F5F5);  // TODO: apply the alpha channel.
 }
 
+const char*  //
+test_wuffs_webp_decode_quirk_defer_loop_filter() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+
+  // bricks-color.lossy.webp is 160×120 pixels, or 10×8 macroblocks.
+  // harvesters.lossy.webp is 1165×859 pixels, or 73×54 macroblocks.
+  const char* filenames[2] = {
+      "test/data/bricks-color.lossy.webp",
+      "test/data/harvesters.lossy.webp",
+  };
+  const int want_num_suspensions[2] = {9, 55};
+  for (int i = 0; i < 2; i++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, filenames[i]));
+
+    for (int q = 0; q < 2; q++) {
+      src.meta.ri = 0;
+
+      wuffs_webp__decoder* dec = &g_webp_decoder;
+      CHECK_STATUS("initialize",
+                   wuffs_webp__decoder__initialize(
+                       dec, sizeof *dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STATUS("set_quirk",
+                   wuffs_webp__decoder__set_quirk(
+                       dec, WUFFS_VP8__QUIRK_DEFER_LOOP_FILTER, q));
+
+      wuffs_base__image_config ic = ((wuffs_base__image_config){});
+      CHECK_STATUS("decode_image_config",
+                   wuffs_webp__decoder__decode_image_config(dec, &ic, &src));
+      wuffs_base__pixel_config__set(
+          &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+          wuffs_base__pixel_config__width(&ic.pixcfg),
+          wuffs_base__pixel_config__height(&ic.pixcfg));
+      wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                         &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+      // Filter each row as late as the quirk allows: after the decode_frame
+      // call that follows its "$loop filter row ready" suspension. A delegate,
+      // attached after the first suspension, does the filtering.
+      wuffs_vp8__decoder* delegate = &g_vp8_delegates[0];
+      int num_suspensions = 0;
+      while (true) {
+        wuffs_base__status status = wuffs_webp__decoder__decode_frame(
+            dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8,
+            NULL);
+        if (num_suspensions > 0) {
+          wuffs_vp8__decoder__loop_filter_row(delegate, g_work_slice_u8,
+                                              num_suspensions - 1);
+        }
+        if (status.repr == NULL) {
+          break;
+        } else if (status.repr !=
+                   wuffs_vp8__suspension__loop_filter_row_ready) {
+          RETURN_FAIL("%s, q=%d: decode_frame: \"%s\"", filenames[i], q,
+                      status.repr);
+        } else if (num_suspensions == 0) {
+          CHECK_STATUS(
+              "initialize",
+              wuffs_vp8__decoder__initialize(
+                  delegate, sizeof *delegate, WUFFS_VERSION,
+                  WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+          CHECK_STATUS("attach_delegate",
+                       wuffs_vp8__decoder__attach_delegate(
+                           delegate, g_work_slice_u8,
+                           wuffs_base__pixel_config__width(&ic.pixcfg),
+                           wuffs_base__pixel_config__height(&ic.pixcfg), 0));
+        }
+        num_suspensions++;
+      }
+      int w = q ? want_num_suspensions[i] : 0;
+      if (num_suspensions != w) {
+        RETURN_FAIL("%s, q=%d: num_suspensions: have %d, want %d",
+                    filenames[i], q, num_suspensions, w);
+      }
+
+      // The final image should not depend on the quirk value.
+      wuffs_base__io_buffer* dst = q ? &have : &want;
+      dst->meta.wi = 0;
+      CHECK_STRING(copy_to_io_buffer_from_pixel_buffer(
+          dst, &pb, wuffs_base__pixel_config__bounds(&ic.pixcfg)));
+      if (q) {
+        CHECK_STRING(check_io_buffers_equal(filenames[i], &have, &want));
+      }
+    }
+  }
+
+  return NULL;
+}
+
+const char*  //
+test_wuffs_webp_decode_planar_ycbcr() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__slice_u8 pixel_slices[2] = {
+      wuffs_base__make_slice_u8(g_pixel_slice_u8.ptr,
+                                g_pixel_slice_u8.len / 2),
+      wuffs_base__make_slice_u8(g_pixel_slice_u8.ptr + g_pixel_slice_u8.len / 2,
+                                g_pixel_slice_u8.len / 2),
+  };
+  static uint8_t scratch_buffer_2k[2048];
+
+  // Decoding to planar YCbCr and then converting to BGRA (with the same
+  // upsampling and color model as std/vp8 uses) should match decoding
+  // straight to BGRA. peacock.24x19.lossy.webp has an odd height.
+  const char* filenames[2] = {
+      "test/data/bricks-color.lossy.webp",
+      "test/data/peacock.24x19.lossy.webp",
+  };
+  for (int i = 0; i < 2; i++) {
+    for (int q = 0; q < 2; q++) {
+      wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+          .data = g_src_slice_u8,
+      });
+      CHECK_STRING(read_file(&src, filenames[i]));
+
+      wuffs_webp__decoder* dec = &g_webp_decoder;
+      CHECK_STATUS("initialize",
+                   wuffs_webp__decoder__initialize(
+                       dec, sizeof *dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+      wuffs_base__image_config ic = ((wuffs_base__image_config){});
+      CHECK_STATUS("decode_image_config",
+                   wuffs_webp__decoder__decode_image_config(dec, &ic, &src));
+      uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+      uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+      wuffs_base__pixel_config__set(
+          &ic.pixcfg,
+          q ? WUFFS_BASE__PIXEL_FORMAT__YCBCR
+            : WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          q ? WUFFS_BASE__PIXEL_SUBSAMPLING__420
+            : WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+          width, height);
+      if (q) {
+        uint64_t have_len = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+        uint64_t want_len =
+            ((uint64_t)width * height) +
+            (2 * (uint64_t)((width + 1) / 2) * ((height + 1) / 2));
+        if (have_len != want_len) {
+          RETURN_FAIL("%s: pixbuf_len: have %" PRIu64 ", want %" PRIu64,
+                      filenames[i], have_len, want_len);
+        }
+      }
+      wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                         &pb, &ic.pixcfg, pixel_slices[0]));
+      CHECK_STATUS("decode_frame",
+                   wuffs_webp__decoder__decode_frame(
+                       dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                       g_work_slice_u8, NULL));
+
+      wuffs_base__pixel_buffer* dst_pb = &pb;
+      wuffs_base__pixel_buffer bgra_pb = ((wuffs_base__pixel_buffer){});
+      if (q) {
+        wuffs_base__pixel_config bgra_pixcfg = ((wuffs_base__pixel_config){});
+        wuffs_base__pixel_config__set(&bgra_pixcfg,
+                                      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+                                      width, height);
+        CHECK_STATUS("set_from_slice",
+                     wuffs_base__pixel_buffer__set_from_slice(
+                         &bgra_pb, &bgra_pixcfg, pixel_slices[1]));
+        wuffs_base__table_u8 t0 = wuffs_base__pixel_buffer__plane(&pb, 0);
+        wuffs_base__table_u8 t1 = wuffs_base__pixel_buffer__plane(&pb, 1);
+        wuffs_base__table_u8 t2 = wuffs_base__pixel_buffer__plane(&pb, 2);
+        wuffs_base__pixel_swizzler swizzler = ((wuffs_base__pixel_swizzler){});
+        CHECK_STATUS(
+            "swizzle_ycck",
+            wuffs_base__pixel_swizzler__swizzle_ycck(
+                &swizzler, &bgra_pb, wuffs_base__empty_slice_u8(), 0, width,
+                0, height,
+                wuffs_base__make_slice_u8(t0.ptr, t0.width * t0.height),
+                wuffs_base__make_slice_u8(t1.ptr, t1.width * t1.height),
+                wuffs_base__make_slice_u8(t2.ptr, t2.width * t2.height),
+                wuffs_base__empty_slice_u8(), t0.width, t1.width, t2.width, 0,
+                t0.height, t1.height, t2.height, 0, t0.stride, t1.stride,
+                t2.stride, 0, 2, 1, 1, 0, 2, 1, 1, 0,
+                WUFFS_BASE__YCC_MODEL__BT_601_STUDIO_RANGE,
+                2,  // YCC_UPSAMPLING__FANCY_LIKE_LIBWEBP.
+                wuffs_base__make_slice_u8(scratch_buffer_2k,
+                                          sizeof scratch_buffer_2k)));
+        dst_pb = &bgra_pb;
+      }
+
+      wuffs_base__io_buffer* dst = q ? &have : &want;
+      dst->meta.wi = 0;
+      CHECK_STRING(copy_to_io_buffer_from_pixel_buffer(
+          dst, dst_pb, wuffs_base__pixel_config__bounds(&ic.pixcfg)));
+      if (q) {
+        CHECK_STRING(check_io_buffers_equal(filenames[i], &have, &want));
+      }
+    }
+  }
+
+  return NULL;
+}
+
+// decode_webp_via_delegates drives the delegates (as per
+// QUIRK_DELEGATE_MACROBLOCK_ROWS) after dec's decode_frame call suspended with
+// "$macroblock rows ready". Everything runs on this one thread, but each
+// delegate only advances by a few macroblocks at a time, interleaving them
+// like a multi-threaded wavefront would.
+const char*  //
+decode_webp_via_delegates(wuffs_webp__decoder* dec,
+                          uint32_t width,
+                          uint32_t height) {
+  uint32_t n = wuffs_webp__decoder__num_token_partitions(dec);
+  if ((n < 2) || (n > 8)) {
+    RETURN_FAIL("num_token_partitions: have %" PRIu32 ", want 2 ..= 8", n);
+  }
+  for (uint32_t p = 0; p < n; p++) {
+    wuffs_vp8__decoder* d = &g_vp8_delegates[p];
+    CHECK_STATUS("initialize",
+                 wuffs_vp8__decoder__initialize(
+                     d, sizeof *d, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("attach_delegate",
+                 wuffs_vp8__decoder__attach_delegate(d, g_work_slice_u8, width,
+                                                     height, p));
+  }
+
+  uint32_t mbw = (width + 15) / 16;
+  uint32_t mbh = (height + 15) / 16;
+  uint32_t progress[0x400] = {0};
+  uint32_t rows[8] = {0};
+  for (uint32_t p = 0; p < n; p++) {
+    rows[p] = p;
+  }
+  uint32_t num_filtered = 0;
+
+  while (num_filtered < mbh) {
+    bool busy = false;
+    for (uint32_t p = 0; p < n; p++) {
+      uint32_t mby = rows[p];
+      if (mby >= mbh) {
+        continue;
+      }
+      uint32_t above = (mby > 0) ? progress[mby - 1] : mbw;
+      uint32_t mbx_end = (above >= mbw) ? mbw : (above > 0) ? (above - 1) : 0;
+      if (mbx_end > (progress[mby] + 3)) {
+        mbx_end = progress[mby] + 3;
+      }
+      if (mbx_end <= progress[mby]) {
+        continue;
+      }
+      CHECK_STATUS("decode_delegated_macroblocks",
+                   wuffs_vp8__decoder__decode_delegated_macroblocks(
+                       &g_vp8_delegates[p], g_work_slice_u8, mby, mbx_end));
+      progress[mby] = mbx_end;
+      if (mbx_end == mbw) {
+        rows[p] += n;
+      }
+      busy = true;
+    }
+
+    while ((num_filtered < mbh) && (progress[num_filtered] == mbw) &&
+           (((num_filtered + 1) == mbh) ||
+            (progress[num_filtered + 1] == mbw))) {
+      wuffs_vp8__decoder__loop_filter_row(&g_vp8_delegates[num_filtered % n],
+                                          g_work_slice_u8, num_filtered);
+      num_filtered++;
+      busy = true;
+    }
+
+    if (!busy) {
+      RETURN_FAIL("no progress after %" PRIu32 " filtered rows", num_filtered);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_webp_decode_quirk_delegate_macroblock_rows() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  wuffs_base__io_buffer want = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+
+  // The N-partitions files should decode to the same pixels as the files
+  // that they were derived from. A single-partition file should not suspend.
+  const char* filenames[3][2] = {
+      {"test/data/bricks-color.lossy.webp",
+       "test/data/bricks-color.lossy.webp"},
+      {"test/data/bricks-color.4-partitions.lossy.webp",
+       "test/data/bricks-color.lossy.webp"},
+      {"test/data/hibiscus.regular.8-partitions.lossy.webp",
+       "test/data/hibiscus.regular.lossy.webp"},
+  };
+  for (int i = 0; i < 3; i++) {
+    for (int q = 0; q < 2; q++) {
+      wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+          .data = g_src_slice_u8,
+      });
+      CHECK_STRING(read_file(&src, filenames[i][q ? 0 : 1]));
+
+      wuffs_webp__decoder* dec = &g_webp_decoder;
+      CHECK_STATUS("initialize",
+                   wuffs_webp__decoder__initialize(
+                       dec, sizeof *dec, WUFFS_VERSION,
+                       WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      CHECK_STATUS("set_quirk",
+                   wuffs_webp__decoder__set_quirk(
+                       dec, WUFFS_VP8__QUIRK_DELEGATE_MACROBLOCK_ROWS, q));
+
+      wuffs_base__image_config ic = ((wuffs_base__image_config){});
+      CHECK_STATUS("decode_image_config",
+                   wuffs_webp__decoder__decode_image_config(dec, &ic, &src));
+      uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+      uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+      wuffs_base__pixel_config__set(&ic.pixcfg,
+                                    WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                    WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                    height);
+      wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                         &pb, &ic.pixcfg, g_pixel_slice_u8));
+
+      int num_suspensions = 0;
+      while (true) {
+        wuffs_base__status status = wuffs_webp__decoder__decode_frame(
+            dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8,
+            NULL);
+        if (status.repr == NULL) {
+          break;
+        } else if (status.repr !=
+                   wuffs_vp8__suspension__macroblock_rows_ready) {
+          RETURN_FAIL("%s, q=%d: decode_frame: \"%s\"", filenames[i][0], q,
+                      status.repr);
+        }
+        num_suspensions++;
+        CHECK_STRING(decode_webp_via_delegates(dec, width, height));
+      }
+      int w = (q && (i > 0)) ? 1 : 0;
+      if (num_suspensions != w) {
+        RETURN_FAIL("%s, q=%d: num_suspensions: have %d, want %d",
+                    filenames[i][0], q, num_suspensions, w);
+      }
+
+      wuffs_base__io_buffer* dst = q ? &have : &want;
+      dst->meta.wi = 0;
+      CHECK_STRING(copy_to_io_buffer_from_pixel_buffer(
+          dst, &pb, wuffs_base__pixel_config__bounds(&ic.pixcfg)));
+      if (q) {
+        CHECK_STRING(check_io_buffers_equal(filenames[i][0], &have, &want));
+      }
+    }
+  }
+
+  return NULL;
+}
+
 const char*  //
 test_wuffs_webp_decode_many_small_reads() {
   CHECK_FOCUS(__func__);
@@ -221,6 +722,227 @@ test_wuffs_webp_decode_many_small_reads() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_webp_apply_transforms() {
+  CHECK_FOCUS(__func__);
+
+  // An odd width, and a width that is not a multiple of the tile width,
+  // exercises the SIMD implementations' non-SIMD tails.
+  const uint32_t width = 37;
+  const uint32_t height = 9;
+  const size_t n = 4 * width * height;
+  wuffs_base__slice_u8 src = wuffs_base__make_slice_u8(g_src_array_u8, n);
+  wuffs_base__slice_u8 tile_data =
+      wuffs_base__make_slice_u8(g_work_array_u8, 4096);
+  fill_webp_transform_inputs(src, tile_data);
+
+  for (uint32_t transform_type = 0; transform_type < 3; transform_type++) {
+    for (uint32_t tile_size_log2 = 2; tile_size_log2 <= 4; tile_size_log2++) {
+      for (int f = 0; f < 3; f++) {
+        const char* func_name = NULL;
+        webp_transform_implementation impl =
+            webp_transform_implementation_for(transform_type, f, &func_name);
+        if (!webp_transform_implementation_is_available(&impl)) {
+          continue;
+        }
+
+        wuffs_webp__decoder* dec = &g_webp_decoder;
+        CHECK_STATUS(
+            "initialize",
+            wuffs_webp__decoder__initialize(
+                dec, sizeof *dec, WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+        dec->private_impl.f_height = height;
+        dec->private_impl.f_transform_tile_size_log2[transform_type] =
+            (uint8_t)tile_size_log2;
+
+        // The f == 0 implementation's output is the "want" for f > 0.
+        uint8_t* dst_ptr = (f == 0) ? g_want_array_u8 : g_have_array_u8;
+        memcpy(dst_ptr, src.ptr, n);
+        webp_transform_implementation_run(
+            &impl, dec, wuffs_base__make_slice_u8(dst_ptr, n), width,
+            tile_data);
+        if (f == 0) {
+          continue;
+        }
+
+        wuffs_base__io_buffer have =
+            wuffs_base__ptr_u8__reader(g_have_array_u8, n, true);
+        wuffs_base__io_buffer want =
+            wuffs_base__ptr_u8__reader(g_want_array_u8, n, true);
+        char prefix[256];
+        snprintf(prefix, 256,
+                 "transform_type=%" PRIu32 ", tile_size_log2=%" PRIu32
+                 ", f=%d (%s): ",
+                 transform_type, tile_size_log2, f, func_name);
+        CHECK_STRING(check_io_buffers_equal(prefix, &have, &want));
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+do_wuffs_webp_decode_to_pixel_buffer(wuffs_base__pixel_buffer* pb,
+                                     wuffs_base__slice_u8 pixbuf,
+                                     uint32_t pixfmt_repr,
+                                     wuffs_base__io_buffer* src) {
+  wuffs_webp__decoder* dec = &g_webp_decoder;
+  CHECK_STATUS("initialize",
+               wuffs_webp__decoder__initialize(
+                   dec, sizeof *dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_webp__decoder__decode_image_config(dec, &ic, src));
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, pixfmt_repr, WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+      wuffs_base__pixel_config__width(&ic.pixcfg),
+      wuffs_base__pixel_config__height(&ic.pixcfg));
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     pb, &ic.pixcfg, pixbuf));
+  CHECK_STATUS("decode_frame",
+               wuffs_webp__decoder__decode_frame(
+                   dec, pb, src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8,
+                   NULL));
+  return NULL;
+}
+
+const char*  //
+do_wuffs_webp_encode(wuffs_base__io_buffer* dst,
+                     wuffs_base__pixel_buffer* src,
+                     uint64_t quality,
+                     uint64_t dst_limit) {
+  wuffs_webp__encoder* enc = &g_webp_encoder;
+  CHECK_STATUS("initialize",
+               wuffs_webp__encoder__initialize(
+                   enc, sizeof *enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("set_quirk", wuffs_webp__encoder__set_quirk(
+                                enc, WUFFS_BASE__QUIRK_QUALITY, quality));
+
+  uint64_t workbuf_len =
+      wuffs_webp__encoder__workbuf_len(
+          enc, wuffs_base__pixel_config__width(&src->pixcfg),
+          wuffs_base__pixel_config__height(&src->pixcfg),
+          wuffs_base__pixel_buffer__pixel_format(src))
+          .min_incl;
+  if (workbuf_len > g_work_slice_u8.len) {
+    RETURN_FAIL("workbuf_len: have %" PRIu64 ", want <= %zu", workbuf_len,
+                g_work_slice_u8.len);
+  }
+  wuffs_base__slice_u8 workbuf =
+      wuffs_base__make_slice_u8(g_work_slice_u8.ptr, workbuf_len);
+
+  const size_t capacity = dst->data.len;
+  while (true) {
+    dst->data.len = capacity;
+    if ((capacity - dst->meta.wi) > dst_limit) {
+      dst->data.len = dst->meta.wi + dst_limit;
+    }
+    wuffs_base__status status =
+        wuffs_webp__encoder__encode_image(enc, dst, src, workbuf);
+    dst->data.len = capacity;
+    if (wuffs_base__status__is_ok(&status)) {
+      break;
+    } else if (status.repr != wuffs_base__suspension__short_write) {
+      RETURN_FAIL("encode_image: %s", status.repr);
+    } else if (dst->meta.wi >= capacity) {
+      RETURN_FAIL("encode_image: dst buffer is too small");
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+do_test_wuffs_webp_encode_round_trip(const char* filename,
+                                     uint32_t pixfmt_repr,
+                                     uint64_t quality,
+                                     uint64_t dst_limit,
+                                     uint64_t want_max_encoded_len) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_webp_decode_to_pixel_buffer(&want_pb, g_want_slice_u8,
+                                                    pixfmt_repr, &src));
+
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  CHECK_STRING(do_wuffs_webp_encode(&encoded, &want_pb, quality, dst_limit));
+  if (encoded.meta.wi > want_max_encoded_len) {
+    RETURN_FAIL("encoded length: have %zu, want <= %" PRIu64, encoded.meta.wi,
+                want_max_encoded_len);
+  }
+  encoded.meta.closed = true;
+
+  wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_webp_decode_to_pixel_buffer(&have_pb, g_pixel_slice_u8,
+                                                    pixfmt_repr, &encoded));
+
+  uint64_t n = wuffs_base__pixel_config__pixbuf_len(&want_pb.pixcfg);
+  wuffs_base__io_buffer have = wuffs_base__ptr_u8__reader(
+      wuffs_base__pixel_buffer__plane(&have_pb, 0).ptr, n, true);
+  wuffs_base__io_buffer want = wuffs_base__ptr_u8__reader(
+      wuffs_base__pixel_buffer__plane(&want_pb, 0).ptr, n, true);
+  return check_io_buffers_equal("", &have, &want);
+}
+
+// The want_max_encoded_len values are a little more than the sizes of the
+// test/data/*.lossless.webp files, which were produced by cwebp.
+
+const char*  //
+test_wuffs_webp_encode_round_trip_fast() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_webp_encode_round_trip(
+      "test/data/hat.lossless.webp", WUFFS_BASE__PIXEL_FORMAT__BGR,
+      WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY, UINT64_MAX, 24000);
+}
+
+const char*  //
+test_wuffs_webp_encode_round_trip_default() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_webp_encode_round_trip(
+      "test/data/hat.lossless.webp", WUFFS_BASE__PIXEL_FORMAT__BGR, 0,
+      UINT64_MAX, 23000);
+}
+
+const char*  //
+test_wuffs_webp_encode_round_trip_small() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_webp_encode_round_trip(
+      "test/data/hat.lossless.webp", WUFFS_BASE__PIXEL_FORMAT__BGR,
+      WUFFS_BASE__QUIRK_QUALITY__VALUE__HIGHER_QUALITY, UINT64_MAX, 22500);
+}
+
+const char*  //
+test_wuffs_webp_encode_round_trip_alpha() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_webp_encode_round_trip(
+      "test/data/hibiscus.primitive.lossless.webp",
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 0, UINT64_MAX, 32000);
+}
+
+const char*  //
+test_wuffs_webp_encode_round_trip_gray() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_webp_encode_round_trip(
+      "test/data/bricks-gray.lossless.webp", WUFFS_BASE__PIXEL_FORMAT__Y, 0,
+      UINT64_MAX, 12000);
+}
+
+const char*  //
+test_wuffs_webp_encode_round_trip_short_writes() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_webp_encode_round_trip(
+      "test/data/pjw-thumbnail.lossless.webp",
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, 0, 7, 300);
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -318,6 +1040,71 @@ test_mimic_webp_lossy_decode_image_4002k_24bpp() {
 
 // ---------------- WebP Benches
 
+const char*  //
+do_wuffs_webp_encode_bench(uint64_t* n_bytes_out,
+                           wuffs_base__io_buffer* dst,
+                           wuffs_base__pixel_buffer* src,
+                           uint64_t quality) {
+  CHECK_STRING(do_wuffs_webp_encode(dst, src, quality, UINT64_MAX));
+  if (n_bytes_out) {
+    *n_bytes_out += wuffs_base__pixel_config__pixbuf_len(&src->pixcfg);
+  }
+  return NULL;
+}
+
+const char*  //
+wuffs_webp_encode(uint64_t* n_bytes_out,
+                  wuffs_base__io_buffer* dst,
+                  wuffs_base__pixel_buffer* src) {
+  return do_wuffs_webp_encode_bench(n_bytes_out, dst, src, 0);
+}
+
+const char*  //
+wuffs_webp_encode_fast(uint64_t* n_bytes_out,
+                       wuffs_base__io_buffer* dst,
+                       wuffs_base__pixel_buffer* src) {
+  return do_wuffs_webp_encode_bench(
+      n_bytes_out, dst, src, WUFFS_BASE__QUIRK_QUALITY__VALUE__LOWER_QUALITY);
+}
+
+const char*  //
+wuffs_webp_encode_small(uint64_t* n_bytes_out,
+                        wuffs_base__io_buffer* dst,
+                        wuffs_base__pixel_buffer* src) {
+  return do_wuffs_webp_encode_bench(
+      n_bytes_out, dst, src, WUFFS_BASE__QUIRK_QUALITY__VALUE__HIGHER_QUALITY);
+}
+
+const char*  //
+do_bench_webp_encode(const char* (*encode_func)(uint64_t* n_bytes_out,
+                                                wuffs_base__io_buffer* dst,
+                                                wuffs_base__pixel_buffer* src),
+                     const char* filename,
+                     uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STRING(do_wuffs_webp_decode_to_pixel_buffer(
+      &pb, g_pixel_slice_u8, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL, &src));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    wuffs_base__io_buffer dst = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    CHECK_STRING((*encode_func)(&n_bytes, &dst, &pb));
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+// --------
+
 const char*  //
 bench_wuffs_webp_lossless_decode_image_19k_8bpp() {
   CHECK_FOCUS(__func__);
@@ -369,6 +1156,41 @@ bench_wuffs_webp_lossless_decode_image_4002k_24bpp() {
       NULL, 0, "test/data/harvesters.lossless.webp", 0, SIZE_MAX, 1);
 }
 
+const char*  //
+bench_wuffs_webp_lossless_encode_image_40k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_webp_encode(&wuffs_webp_encode,
+                              "test/data/hat.lossless.webp", 30);
+}
+
+const char*  //
+bench_wuffs_webp_lossless_encode_image_552k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_webp_encode(&wuffs_webp_encode,
+                              "test/data/hibiscus.primitive.lossless.webp", 4);
+}
+
+const char*  //
+bench_wuffs_webp_lossless_encode_image_4002k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_webp_encode(&wuffs_webp_encode,
+                              "test/data/harvesters.lossless.webp", 1);
+}
+
+const char*  //
+bench_wuffs_webp_lossless_encode_image_4002k_24bpp_fast() {
+  CHECK_FOCUS(__func__);
+  return do_bench_webp_encode(&wuffs_webp_encode_fast,
+                              "test/data/harvesters.lossless.webp", 1);
+}
+
+const char*  //
+bench_wuffs_webp_lossless_encode_image_4002k_24bpp_small() {
+  CHECK_FOCUS(__func__);
+  return do_bench_webp_encode(&wuffs_webp_encode_small,
+                              "test/data/harvesters.lossless.webp", 1);
+}
+
 const char*  //
 bench_wuffs_webp_lossy_decode_image_19k_8bpp() {
   CHECK_FOCUS(__func__);
@@ -420,6 +1242,65 @@ bench_wuffs_webp_lossy_decode_image_4002k_24bpp() {
       NULL, 0, "test/data/harvesters.lossy.webp", 0, SIZE_MAX, 1);
 }
 
+const char*  //
+do_bench_wuffs_webp_apply_transform(uint32_t transform_type,
+                                    uint64_t iters_unscaled) {
+  const uint32_t width = 1024;
+  const uint32_t height = 256;
+  const size_t n = 4 * width * height;
+  wuffs_base__slice_u8 pix = wuffs_base__make_slice_u8(g_pixel_array_u8, n);
+  wuffs_base__slice_u8 tile_data =
+      wuffs_base__make_slice_u8(g_work_array_u8, 65536);
+  fill_webp_transform_inputs(pix, tile_data);
+
+  // Use the fastest available implementation, as the decoder does.
+  const char* func_name = NULL;
+  webp_transform_implementation impl = {NULL, NULL};
+  for (int f = 2;
+       (f >= 0) && !webp_transform_implementation_is_available(&impl); f--) {
+    impl = webp_transform_implementation_for(transform_type, f, &func_name);
+  }
+  if (!webp_transform_implementation_is_available(&impl)) {
+    return "no implementation";
+  }
+
+  wuffs_webp__decoder* dec = &g_webp_decoder;
+  CHECK_STATUS("initialize",
+               wuffs_webp__decoder__initialize(
+                   dec, sizeof *dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  dec->private_impl.f_height = height;
+  dec->private_impl.f_transform_tile_size_log2[transform_type] = 4;
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    webp_transform_implementation_run(&impl, dec, pix, width, tile_data);
+    n_bytes += n;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_webp_apply_transform_predictor() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_webp_apply_transform(0, 20);
+}
+
+const char*  //
+bench_wuffs_webp_apply_transform_cross_color() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_webp_apply_transform(1, 50);
+}
+
+const char*  //
+bench_wuffs_webp_apply_transform_subtract_green() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_webp_apply_transform(2, 100);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -475,6 +1356,27 @@ bench_mimic_webp_lossless_decode_image_4002k_24bpp() {
       NULL, 0, "test/data/harvesters.lossless.webp", 0, SIZE_MAX, 1);
 }
 
+const char*  //
+bench_mimic_webp_lossless_encode_image_40k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_webp_encode(&mimic_webp_encode,
+                              "test/data/hat.lossless.webp", 30);
+}
+
+const char*  //
+bench_mimic_webp_lossless_encode_image_552k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_webp_encode(&mimic_webp_encode,
+                              "test/data/hibiscus.primitive.lossless.webp", 4);
+}
+
+const char*  //
+bench_mimic_webp_lossless_encode_image_4002k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_webp_encode(&mimic_webp_encode,
+                              "test/data/harvesters.lossless.webp", 1);
+}
+
 const char*  //
 bench_mimic_webp_lossy_decode_image_19k_8bpp() {
   CHECK_FOCUS(__func__);
@@ -532,10 +1434,20 @@ bench_mimic_webp_lossy_decode_image_4002k_24bpp() {
 
 proc g_tests[] = {
 
+    test_wuffs_webp_apply_transforms,
     test_wuffs_webp_decode_interface_lossless,
     test_wuffs_webp_decode_interface_lossy,
     test_wuffs_webp_decode_interface_vp8x_alpha_lossy,
     test_wuffs_webp_decode_many_small_reads,
+    test_wuffs_webp_decode_planar_ycbcr,
+    test_wuffs_webp_decode_quirk_defer_loop_filter,
+    test_wuffs_webp_decode_quirk_delegate_macroblock_rows,
+    test_wuffs_webp_encode_round_trip_alpha,
+    test_wuffs_webp_encode_round_trip_default,
+    test_wuffs_webp_encode_round_trip_fast,
+    test_wuffs_webp_encode_round_trip_gray,
+    test_wuffs_webp_encode_round_trip_short_writes,
+    test_wuffs_webp_encode_round_trip_small,
 
 #ifdef WUFFS_MIMIC
 
@@ -557,11 +1469,19 @@ proc g_tests[] = {
 
 proc g_benches[] = {
 
+    bench_wuffs_webp_apply_transform_cross_color,
+    bench_wuffs_webp_apply_transform_predictor,
+    bench_wuffs_webp_apply_transform_subtract_green,
     bench_wuffs_webp_lossless_decode_image_19k_8bpp,
     bench_wuffs_webp_lossless_decode_image_40k_24bpp,
     bench_wuffs_webp_lossless_decode_image_77k_8bpp,
     bench_wuffs_webp_lossless_decode_image_552k_32bpp,
     bench_wuffs_webp_lossless_decode_image_4002k_24bpp,
+    bench_wuffs_webp_lossless_encode_image_40k_24bpp,
+    bench_wuffs_webp_lossless_encode_image_552k_32bpp,
+    bench_wuffs_webp_lossless_encode_image_4002k_24bpp,
+    bench_wuffs_webp_lossless_encode_image_4002k_24bpp_fast,
+    bench_wuffs_webp_lossless_encode_image_4002k_24bpp_small,
     bench_wuffs_webp_lossy_decode_image_19k_8bpp,
     bench_wuffs_webp_lossy_decode_image_40k_24bpp,
     bench_wuffs_webp_lossy_decode_image_77k_24bpp,
@@ -575,6 +1495,9 @@ proc g_benches[] = {
     bench_mimic_webp_lossless_decode_image_77k_8bpp,
     bench_mimic_webp_lossless_decode_image_552k_32bpp,
     bench_mimic_webp_lossless_decode_image_4002k_24bpp,
+    bench_mimic_webp_lossless_encode_image_40k_24bpp,
+    bench_mimic_webp_lossless_encode_image_552k_32bpp,
+    bench_mimic_webp_lossless_encode_image_4002k_24bpp,
     bench_mimic_webp_lossy_decode_image_19k_8bpp,
     bench_mimic_webp_lossy_decode_image_40k_24bpp,
     bench_mimic_webp_lossy_decode_image_77k_24bpp,
@@ -82,6 +82,12 @@ golden_test g_zlib_pi_gt = {
     .src_filename = "test/data/pi.txt.zlib",
 };
 
+// The encoder benchmarks' src files are not compressed.
+
+golden_test g_zlib_encode_pi_gt = {
+    .src_filename = "test/data/pi.txt",
+};
+
 // This dictionary-using zlib-encoded data comes from
 // https://play.golang.org/p/Jh9Wyp6PLID, also mentioned in the RAC spec.
 const char* g_zlib_sheep_src_ptr =
@@ -359,6 +365,62 @@ test_wuffs_zlib_decode_sheep() {
   return check_io_buffers_equal("", &have, &want);
 }
 
+const char*  //
+wuffs_zlib_encode(wuffs_base__io_buffer* dst,
+                  wuffs_base__io_buffer* src,
+                  uint32_t wuffs_initialize_flags,
+                  uint64_t wlimit,
+                  uint64_t rlimit) {
+  wuffs_zlib__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_zlib__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION, wuffs_initialize_flags));
+
+  while (true) {
+    wuffs_base__io_buffer limited_dst = make_limited_writer(*dst, wlimit);
+    wuffs_base__io_buffer limited_src = make_limited_reader(*src, rlimit);
+
+    wuffs_base__status status = wuffs_zlib__encoder__transform_io(
+        &enc, &limited_dst, &limited_src, g_work_slice_u8);
+
+    dst->meta.wi += limited_dst.meta.wi;
+    src->meta.ri += limited_src.meta.ri;
+
+    if (((wlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_write)) ||
+        ((rlimit < UINT64_MAX) &&
+         (status.repr == wuffs_base__suspension__short_read))) {
+      continue;
+    }
+    return status.repr;
+  }
+}
+
+const char*  //
+test_wuffs_zlib_encode_round_trip() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  wuffs_base__io_buffer encoded = ((wuffs_base__io_buffer){
+      .data = g_want_slice_u8,
+  });
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+
+  CHECK_STRING(read_file(&src, "test/data/pi.txt"));
+  CHECK_STRING(wuffs_zlib_encode(
+      &encoded, &src, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      1000, 777));
+  encoded.meta.closed = true;
+  CHECK_STRING(wuffs_zlib_decode(
+      &have, &encoded, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      UINT64_MAX, UINT64_MAX));
+  return check_io_buffers_equal("", &have, &src);
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -418,6 +480,14 @@ bench_wuffs_zlib_decode_100k() {
       tcounter_dst, &g_zlib_pi_gt, UINT64_MAX, UINT64_MAX, 30);
 }
 
+const char*  //
+bench_wuffs_zlib_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(
+      wuffs_zlib_encode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      tcounter_src, &g_zlib_encode_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -436,6 +506,26 @@ bench_mimic_zlib_decode_100k() {
                              UINT64_MAX, UINT64_MAX, 30);
 }
 
+#ifndef WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE
+
+const char*  //
+mimic_zlib_encode_level_6(wuffs_base__io_buffer* dst,
+                          wuffs_base__io_buffer* src,
+                          uint32_t wuffs_initialize_flags,
+                          uint64_t wlimit,
+                          uint64_t rlimit) {
+  return mimic_zlib_encode(dst, src, 6);
+}
+
+const char*  //
+bench_mimic_zlib_encode_100k() {
+  CHECK_FOCUS(__func__);
+  return do_bench_io_buffers(mimic_zlib_encode_level_6, 0, tcounter_src,
+                             &g_zlib_encode_pi_gt, UINT64_MAX, UINT64_MAX, 30);
+}
+
+#endif  // WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE
+
 #endif  // WUFFS_MIMIC
 
 // ---------------- Manifest
@@ -452,6 +542,7 @@ proc g_tests[] = {
     test_wuffs_zlib_decode_raw_deflate_romeo,
     test_wuffs_zlib_decode_sheep,
     test_wuffs_zlib_decode_truncated_input,
+    test_wuffs_zlib_encode_round_trip,
 
 #ifdef WUFFS_MIMIC
 
@@ -470,11 +561,15 @@ proc g_benches[] = {
 
     bench_wuffs_zlib_decode_10k,
     bench_wuffs_zlib_decode_100k,
+    bench_wuffs_zlib_encode_100k,
 
 #ifdef WUFFS_MIMIC
 
     bench_mimic_zlib_decode_10k,
     bench_mimic_zlib_decode_100k,
+#ifndef WUFFS_MIMICLIB_DEFLATE_DOES_NOT_SUPPORT_ENCODE
+    bench_mimic_zlib_encode_100k,
+#endif
 
 #endif  // WUFFS_MIMIC
 